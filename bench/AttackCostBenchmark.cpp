@@ -0,0 +1,176 @@
+// Attack costs of 1,000 AI garrisons against their AI_TARGETS_PER_GARRISON closest structures on a map of 10,000.
+// The per-pair path looks the target's garrison and shield up by ID in hash tables and computes the distance from
+// the positions the way the planner used to. The batched path takes distances and flight times from the distance
+// table, gathers the target's values next to them, and runs the cost kernel at each SIMD level.
+// The kernel is also timed per call on the pairs of one AI: one garrison, ten and a hundred, as the planner calls it.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/EntityManager.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Game/DistanceTable.hpp"
+#include "Game/StructureIndex.hpp"
+#include "Utils/AttackCostKernel.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr size_t STRUCTURES = 10000;
+    constexpr size_t ORIGINS = 1000;
+    constexpr int PASSES = 100;
+    constexpr size_t CALL_PAIRS = 2000000;     // Pairs costed per size and level in the per-call timing
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Garisson {
+        unsigned int droneCount;
+    };
+
+    struct Shield {
+        float shield;
+        float regenRate;
+    };
+}
+
+int main() {
+    // The generated maps hold about 32 structures on one screen
+    float scale = std::sqrt(STRUCTURES / 32.f);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> coordX(0.f, Config::MAP_WIDTH * scale);
+    std::uniform_real_distribution<float> coordY(0.f, Config::MAP_HEIGHT * scale);
+    std::uniform_int_distribution<unsigned int> droneCount(0, 100);
+    std::uniform_real_distribution<float> shieldValue(0.f, 50.f);
+    std::uniform_real_distribution<float> regen(0.f, 2.f);
+
+    std::vector<EntityID> ids;
+    std::vector<sf::Vector2f> positions;
+    std::vector<float> drones, shield, regenRate;
+    std::unordered_map<EntityID, sf::Vector2f> positionByID;
+    std::unordered_map<EntityID, Garisson> garissons;
+    std::unordered_map<EntityID, Shield> shields;
+    Game::StructureIndex index;
+    for (size_t i = 0; i < STRUCTURES; ++i) {
+        EntityID id = i + 1;
+        ids.push_back(id);
+        positions.push_back({coordX(gen), coordY(gen)});
+        drones.push_back(static_cast<float>(droneCount(gen)));
+        shield.push_back(shieldValue(gen));
+        regenRate.push_back(regen(gen));
+        positionByID.emplace(id, positions.back());
+        garissons.emplace(id, Garisson{static_cast<unsigned int>(drones.back())});
+        shields.emplace(id, Shield{shield.back(), regenRate.back()});
+        index.addStructure(id, positions.back(), Components::Faction::NEUTRAL);
+    }
+
+    Game::DistanceTable distances;
+    distances.build(ids, positions);
+
+    // Candidate targets closest first, as the perception finds them
+    std::vector<std::pair<EntityID, EntityID>> pairs;
+    std::vector<Game::StructureIndex::Neighbour> nearest;
+    for (size_t origin = 0; origin < ORIGINS; ++origin) {
+        EntityID originID = ids[origin];
+        index.nearest(positions[origin], Config::AI_TARGETS_PER_GARRISON, std::numeric_limits<float>::infinity(),
+                      [originID](EntityID id, Components::Faction) { return id != originID; }, nearest);
+        for (auto [distance, targetID] : nearest) {
+            pairs.emplace_back(originID, targetID);
+        }
+    }
+
+    std::vector<float> pairCost(pairs.size());
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            auto [originID, targetID] = pairs[i];
+            sf::Vector2f delta = positionByID.at(targetID) - positionByID.at(originID);
+            const Shield& targetShield = shields.at(targetID);
+            float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            float travelTime = Components::MoveComponent::getFlightTime(distance, Config::DRONE_SPEED);
+            pairCost[i] = garissons.at(targetID).droneCount + targetShield.shield + travelTime * targetShield.regenRate;
+        }
+    }
+    double perPair = secondsSince(start);
+
+    std::printf("Attack cost benchmark, %zu garrisons x %u candidates among %zu structures, %s available\n", ORIGINS,
+                Config::AI_TARGETS_PER_GARRISON, STRUCTURES, Utils::Simd::getLevelName(Utils::Simd::getLevel()));
+    std::printf("per pair  %8.3f ms  %6.2f ns per pair\n", perPair * 1000.0 / PASSES, perPair * 1e9 / (PASSES * pairs.size()));
+
+    // The target's values are read once per target and gathered per pair, as the planner does
+    std::vector<float> pairDistance(pairs.size()), travelTime(pairs.size()), pairDrones(pairs.size()), pairShield(pairs.size()),
+                       pairRegenRate(pairs.size()), cost(pairs.size());
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            auto [originID, targetID] = pairs[i];
+            auto entry = distances.get(originID, targetID);
+            size_t target = targetID - 1;
+            pairDistance[i] = entry.distance;
+            travelTime[i] = entry.travelTime;
+            pairDrones[i] = drones[target];
+            pairShield[i] = shield[target];
+            pairRegenRate[i] = regenRate[target];
+        }
+    }
+    double gather = secondsSince(start);
+    std::printf("gather    %8.3f ms  %6.2f ns per pair, distance table %s\n", gather * 1000.0 / PASSES, gather * 1e9 / (PASSES * pairs.size()),
+                distances.isFullMatrix() ? "full matrix" : "neighbour lists");
+
+    Utils::Kernels::AttackCostBatch batch{
+        travelTime.data(), pairDrones.data(), pairShield.data(), pairRegenRate.data(), pairs.size(),
+        cost.data()
+    };
+
+    for (auto level : {Utils::Simd::Level::SCALAR, Utils::Simd::Level::SSE2, Utils::Simd::Level::AVX2}) {
+        if (level > Utils::Simd::getLevel()) {
+            continue;
+        }
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            Utils::Kernels::computeAttackCosts(batch, level);
+        }
+        double kernel = secondsSince(start);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < cost.size(); ++i) {
+            mismatches += cost[i] != pairCost[i];
+        }
+        std::printf("%-8s  %8.3f ms  %6.2f ns per pair, %zu costs differ from the per-pair path\n", Utils::Simd::getLevelName(level),
+                    kernel * 1000.0 / PASSES, kernel * 1e9 / (PASSES * pairs.size()), mismatches);
+    }
+
+    // Per planner call, the vector paths have to pay for their dispatch on a few garrisons' pairs
+    for (size_t garrisons : {1, 10, 100}) {
+        size_t count = garrisons * Config::AI_TARGETS_PER_GARRISON;
+        Utils::Kernels::AttackCostBatch call = batch;
+        call.count = count;
+        size_t calls = CALL_PAIRS / count;
+        std::printf("%3zu garrisons, %4zu pairs:", garrisons, count);
+        for (auto level : {Utils::Simd::Level::SCALAR, Utils::Simd::Level::SSE2, Utils::Simd::Level::AVX2}) {
+            if (level > Utils::Simd::getLevel()) {
+                continue;
+            }
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < calls; ++i) {
+                // A different slice every call, so the calls cannot be folded into one
+                size_t offset = (i * count) % (pairs.size() - count + 1);
+                call.travelTime = travelTime.data() + offset;
+                call.drones = pairDrones.data() + offset;
+                call.shield = pairShield.data() + offset;
+                call.regenRate = pairRegenRate.data() + offset;
+                call.cost = cost.data() + offset;
+                Utils::Kernels::computeAttackCosts(call, level);
+            }
+            std::printf("  %s %7.1f ns", Utils::Simd::getLevelName(level), secondsSince(start) * 1e9 / calls);
+        }
+        std::printf(" per call\n");
+    }
+    return 0;
+}
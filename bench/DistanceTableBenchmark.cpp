@@ -0,0 +1,85 @@
+// Structure distance table on maps of growing size: build time, memory against what the full matrix would take,
+// and the cost of one distance and flight time lookup for random pairs against computing them from positions
+// found by ID in a hash table the way the AI used to. Pairs beyond the neighbour lists are computed either way.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Game/DistanceTable.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr size_t LOOKUPS = 1000000;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void runSize(size_t structureCount) {
+        // The generated maps hold about 32 structures on one screen
+        float scale = std::sqrt(structureCount / 32.f);
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, Config::MAP_WIDTH * scale);
+        std::uniform_real_distribution<float> coordY(0.f, Config::MAP_HEIGHT * scale);
+
+        std::vector<EntityID> ids;
+        std::vector<sf::Vector2f> positions;
+        std::unordered_map<EntityID, sf::Vector2f> byID;
+        for (size_t i = 0; i < structureCount; ++i) {
+            ids.push_back(i + 1);
+            positions.push_back({coordX(gen), coordY(gen)});
+            byID.emplace(ids.back(), positions.back());
+        }
+
+        Game::DistanceTable distances;
+        auto start = std::chrono::steady_clock::now();
+        distances.build(ids, positions);
+        double build = secondsSince(start);
+
+        // Nearby pairs, the ones attacks are planned between, half of them among the nearest neighbours
+        std::uniform_int_distribution<size_t> pick(0, structureCount - 1);
+        std::vector<std::pair<EntityID, EntityID>> pairs;
+        for (size_t i = 0; i < LOOKUPS; ++i) {
+            size_t from = pick(gen);
+            size_t to = i % 2 == 0 ? std::min(structureCount - 1, from + 1) : pick(gen);
+            pairs.emplace_back(ids[from], ids[to]);
+        }
+
+        float scanSum = 0.f;
+        start = std::chrono::steady_clock::now();
+        for (auto [from, to] : pairs) {
+            sf::Vector2f a = byID.at(from);
+            sf::Vector2f b = byID.at(to);
+            float distance = sqrtf(powf(a.x - b.x, 2) + powf(a.y - b.y, 2));
+            scanSum += distance + distance / Config::DRONE_SPEED;
+        }
+        double scan = secondsSince(start);
+
+        float tableSum = 0.f;
+        start = std::chrono::steady_clock::now();
+        for (auto [from, to] : pairs) {
+            auto entry = distances.get(from, to);
+            tableSum += entry.distance + entry.travelTime;
+        }
+        double table = secondsSince(start);
+
+        std::printf("%6zu structures  %-17s %9.1f KB (matrix %10.1f KB)  build %8.3f ms  lookup %6.1f ns, computed %6.1f ns  [%.0f %.0f]\n",
+                    structureCount, distances.isFullMatrix() ? "full matrix" : "nearest neighbours",
+                    distances.getMemoryUsage() / 1024.0, structureCount * structureCount * sizeof(Game::DistanceTable::Entry) / 1024.0,
+                    build * 1000.0, table * 1e9 / LOOKUPS, scan * 1e9 / LOOKUPS, tableSum, scanSum);
+    }
+}
+
+int main() {
+    std::printf("Distance table benchmark, full matrix up to %u structures, %u neighbours beyond\n",
+                Config::DISTANCE_MATRIX_MAX_STRUCTURES, Config::DISTANCE_NEIGHBOURS);
+    for (size_t structureCount : {40, 128, 256, 257, 512, 2048, 8192}) {
+        runSize(structureCount);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Compares the per-entity movement integration the MovementSystem used to run
+// (component lookups, sqrt + atan2, sf::Transformable updates) with the closed-form
+// structure-of-arrays flight kernel in its scalar, SSE2 and AVX2 variants.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "Core/EntityManager.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Utils/FlightKernel.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr float FRAME_DT = 1.f / 60.f;
+
+    // Average milliseconds per call over enough repetitions to run at least minSeconds
+    double measure(const std::function<void()>& frame, double minSeconds = 0.25) {
+        frame(); // warm up
+        int repetitions = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            frame();
+            repetitions++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed * 1000.0 / repetitions;
+    }
+
+    // The MovementSystem loop body before flights were evaluated in closed form
+    void legacyMovementStep(EntityManager& entityManager, float dt) {
+        for (auto& [id, entity] : entityManager.getAllEntities()) {
+            auto* transform = entity.getComponent<Components::TransformComponent>();
+            auto* move = entity.getComponent<Components::MoveComponent>();
+
+            if (transform && move && move->moveToTarget) {
+                sf::Vector2f direction = move->targetPosition - transform->getPosition();
+                float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+
+                float stoppingDistance = std::max(5.0f, move->speed * 0.1f);
+                if (distance > stoppingDistance) {
+                    direction /= distance;
+                    float step = move->speed * dt;
+                    if (step >= distance) {
+                        transform->transform.setPosition(move->targetPosition);
+                        move->moveToTarget = false;
+                    } else {
+                        transform->transform.setPosition(transform->getPosition() + direction * step);
+                        float angle = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG;
+                        transform->transform.setRotation(angle + 90.f);
+                    }
+                } else {
+                    transform->transform.setPosition(move->targetPosition);
+                    move->moveToTarget = false;
+                }
+                transform->transform.setRotation(transform->getRotation() + move->angularVelocity * dt);
+            }
+        }
+    }
+
+    struct Flights {
+        std::vector<float> launchX, launchY, dirX, dirY, speed, launchTime, arrivalTime, targetX, targetY, x, y;
+        std::vector<unsigned char> flags;
+
+        Utils::Kernels::FlightBatch batch() {
+            return {launchX.data(), launchY.data(), dirX.data(), dirY.data(), speed.data(),
+                    launchTime.data(), arrivalTime.data(), targetX.data(), targetY.data(),
+                    x.data(), y.data(), flags.data(), launchX.size()};
+        }
+    };
+
+    void runSize(size_t droneCount, bool includeLegacy) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+
+        Flights flights;
+        EntityManager entityManager;
+
+        for (size_t i = 0; i < droneCount; ++i) {
+            sf::Vector2f from(coordX(gen), coordY(gen));
+            sf::Vector2f to(coordX(gen), coordY(gen));
+
+            Components::MoveComponent move(Config::DRONE_SPEED, 0.f);
+            move.launch(from, to, 0.f);
+
+            flights.launchX.push_back(move.launchPosition.x);
+            flights.launchY.push_back(move.launchPosition.y);
+            flights.dirX.push_back(move.direction.x);
+            flights.dirY.push_back(move.direction.y);
+            flights.speed.push_back(move.speed);
+            flights.launchTime.push_back(static_cast<float>(move.launchTime));
+            flights.arrivalTime.push_back(static_cast<float>(move.arrivalTime));
+            flights.targetX.push_back(to.x);
+            flights.targetY.push_back(to.y);
+
+            if (includeLegacy) {
+                EntityID id = entityManager.createEntity();
+                entityManager.addComponent(id, Components::TransformComponent{from, 0.f, sf::Vector2f(1.f, 1.f)});
+                entityManager.addComponent(id, move);
+            }
+        }
+        flights.x.resize(droneCount);
+        flights.y.resize(droneCount);
+        flights.flags.resize(droneCount);
+
+        Utils::Kernels::ViewRect view{0.f, 0.f, float(Config::SCREEN_WIDTH), float(Config::SCREEN_HEIGHT)};
+        auto batch = flights.batch();
+
+        // Flights stay mid-air during the measurement so no lane takes the arrival branch early
+        float time = 1.f;
+
+        std::printf("%9zu drones\n", droneCount);
+        if (includeLegacy) {
+            double ms = measure([&]() { legacyMovementStep(entityManager, FRAME_DT); });
+            std::printf("    per-entity     %10.3f ms/frame %8.2f ns/drone\n", ms, ms * 1e6 / droneCount);
+        }
+
+        using Utils::Simd::Level;
+        for (Level level : {Level::SCALAR, Level::SSE2, Level::AVX2}) {
+            if (level > Utils::Simd::getLevel()) {
+                std::printf("    SoA %-10s (not supported on this CPU)\n", Utils::Simd::getLevelName(level));
+                continue;
+            }
+            double ms = measure([&]() { Utils::Kernels::evaluateFlights(batch, time, view, level); });
+            std::printf("    SoA %-10s %10.3f ms/frame %8.2f ns/drone\n", Utils::Simd::getLevelName(level), ms, ms * 1e6 / droneCount);
+        }
+    }
+}
+
+int main() {
+    std::printf("Flight kernel benchmark, dispatch selects %s\n", Utils::Simd::getLevelName(Utils::Simd::getLevel()));
+    runSize(10000, true);
+    runSize(100000, true);
+    runSize(1000000, true);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Per-tick cost of fleet flocking: spatial hash rebuild (counting sort, keyed by fleet), steering from the
+// fleet's neighbours in the 3x3 cells around each drone, and integration of the offsets.
+// Fleets of 50 drones are scattered over the map, the all-pairs search is shown for comparison.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "Utils/SpatialHash.hpp"
+#include "Utils/FlockingKernel.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr float TICK_DT = 1.f / 60.f;
+    constexpr size_t FLEET_SIZE = 50;
+
+    // Average milliseconds per call over enough repetitions to run at least minSeconds
+    double measure(const std::function<void()>& tick, double minSeconds = 0.25) {
+        tick(); // warm up
+        int repetitions = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            tick();
+            repetitions++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed * 1000.0 / repetitions;
+    }
+
+    struct Flock {
+        std::vector<float> x, y;
+        std::vector<std::uint32_t> fleet;
+        std::vector<float> offsetX, offsetY, velocityX, velocityY, steerX, steerY;
+
+        Utils::Kernels::FlockBatch batch() {
+            return {x.data(), y.data(), fleet.data(), offsetX.data(), offsetY.data(),
+                    velocityX.data(), velocityY.data(), steerX.data(), steerY.data(), x.size()};
+        }
+    };
+
+    // The same steering, with every drone testing every other one
+    void steerAllPairs(const Utils::Kernels::FlockBatch& batch, const Utils::Kernels::FlockParameters& parameters) {
+        float radiusSquared = parameters.radius * parameters.radius;
+        for (size_t i = 0; i < batch.count; ++i) {
+            float pushX = 0.f, pushY = 0.f;
+            for (size_t j = 0; j < batch.count; ++j) {
+                if (j == i || batch.fleet[j] != batch.fleet[i]) {
+                    continue;
+                }
+                float dx = batch.displayX[i] - batch.displayX[j];
+                float dy = batch.displayY[i] - batch.displayY[j];
+                float distanceSquared = dx * dx + dy * dy;
+                if (distanceSquared < radiusSquared && distanceSquared > 1e-4f) {
+                    float distance = std::sqrt(distanceSquared);
+                    float weight = (parameters.radius - distance) / (parameters.radius * distance);
+                    pushX += dx * weight;
+                    pushY += dy * weight;
+                }
+            }
+            batch.steerX[i] = pushX * parameters.separation;
+            batch.steerY[i] = pushY * parameters.separation;
+        }
+    }
+
+    void runSize(size_t droneCount, bool includeAllPairs) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+        std::normal_distribution<float> spread(0.f, 30.f);
+
+        Flock flock;
+        float centerX = 0.f, centerY = 0.f;
+        for (size_t i = 0; i < droneCount; ++i) {
+            if (i % FLEET_SIZE == 0) {
+                centerX = coordX(gen);
+                centerY = coordY(gen);
+            }
+            flock.x.push_back(centerX + spread(gen));
+            flock.y.push_back(centerY + spread(gen));
+            flock.fleet.push_back(static_cast<std::uint32_t>(i / FLEET_SIZE));
+        }
+        for (auto* values : {&flock.offsetX, &flock.offsetY, &flock.velocityX, &flock.velocityY, &flock.steerX, &flock.steerY}) {
+            values->assign(droneCount, 0.f);
+        }
+
+        const Utils::Kernels::FlockParameters parameters{
+            Config::FLOCK_RADIUS, Config::FLOCK_SEPARATION, Config::FLOCK_COHESION,
+            Config::FLOCK_SPRING, Config::FLOCK_DAMPING, Config::FLOCK_MAX_OFFSET
+        };
+        Utils::SpatialHash hash;
+        auto batch = flock.batch();
+
+        std::printf("%9zu drones\n", droneCount);
+        double build = measure([&]() { hash.build(flock.x.data(), flock.y.data(), flock.fleet.data(), droneCount, Config::FLOCK_RADIUS); });
+        double steer = measure([&]() { Utils::Kernels::steerFlock(batch, hash, parameters, 0, droneCount); });
+        double integrate = measure([&]() { Utils::Kernels::integrateFlock(batch, parameters, TICK_DT, 0, droneCount); });
+        std::printf("    hash build     %10.3f ms/tick %8.2f ns/drone\n", build, build * 1e6 / droneCount);
+        std::printf("    steer          %10.3f ms/tick %8.2f ns/drone\n", steer, steer * 1e6 / droneCount);
+        std::printf("    integrate      %10.3f ms/tick %8.2f ns/drone\n", integrate, integrate * 1e6 / droneCount);
+        std::printf("    total          %10.3f ms/tick %8.2f ns/drone\n", build + steer + integrate, (build + steer + integrate) * 1e6 / droneCount);
+
+        if (includeAllPairs) {
+            double ms = measure([&]() { steerAllPairs(batch, parameters); });
+            std::printf("    all pairs      %10.3f ms/tick %8.2f ns/drone\n", ms, ms * 1e6 / droneCount);
+        }
+    }
+}
+
+int main() {
+    std::printf("Flocking benchmark, fleets of %zu drones\n", FLEET_SIZE);
+    runSize(10000, true);
+    runSize(100000, false);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Hyperlanes on maps of growing size, at the structure density of the generated maps:
+// lane graph and all-pairs next-structure table build, route lookups (first read and cached),
+// and the detour repair after captures block the shortest paths.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Game/Hyperlanes.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr size_t LOOKUPS = 100000;
+    constexpr size_t CAPTURES = 1000;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void runSize(size_t structureCount) {
+        // The generated maps hold about 32 structures on one screen
+        float scale = std::sqrt(structureCount / 32.f);
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, Config::MAP_WIDTH * scale);
+        std::uniform_real_distribution<float> coordY(0.f, Config::MAP_HEIGHT * scale);
+
+        std::vector<EntityID> ids;
+        std::vector<sf::Vector2f> positions;
+        std::vector<Components::Faction> owners(structureCount, Components::Faction::NEUTRAL);
+        for (size_t i = 0; i < structureCount; ++i) {
+            ids.push_back(i + 1);
+            positions.push_back({coordX(gen), coordY(gen)});
+        }
+
+        Game::Hyperlanes hyperlanes;
+        auto start = std::chrono::steady_clock::now();
+        hyperlanes.build(ids, positions, owners);
+        double build = secondsSince(start);
+
+        std::printf("%9zu structures, %zu lanes\n", structureCount, hyperlanes.getLaneCount());
+        std::printf("    build          %10.1f ms, table %.1f MB\n", build * 1000.0, hyperlanes.getTableBytes() / (1024.0 * 1024.0));
+
+        std::uniform_int_distribution<size_t> pick(0, structureCount - 1);
+        std::vector<std::pair<EntityID, EntityID>> pairs;
+        for (size_t i = 0; i < LOOKUPS; ++i) {
+            pairs.emplace_back(ids[pick(gen)], ids[pick(gen)]);
+        }
+        size_t corners = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            start = std::chrono::steady_clock::now();
+            for (auto& [origin, target] : pairs) {
+                auto route = hyperlanes.getRoute(Components::Faction::PLAYER_1, origin, target);
+                corners += route ? route->size() : 0;
+            }
+            double lookup = secondsSince(start);
+            std::printf("    %s %10.3f us/route, %.1f lanes per route\n", pass == 0 ? "first lookup  " : "cached lookup ", lookup * 1e6 / LOOKUPS, static_cast<double>(corners) / LOOKUPS / (pass + 1));
+        }
+
+        // Player 2 takes structures, player 1 has to go around them
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < CAPTURES; ++i) {
+            hyperlanes.setFaction(ids[pick(gen)], Components::Faction::PLAYER_2);
+        }
+        double capture = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < LOOKUPS / 10; ++i) {
+            hyperlanes.getRoute(Components::Faction::PLAYER_1, pairs[i].first, pairs[i].second);
+        }
+        double detour = secondsSince(start);
+        std::printf("    capture        %10.3f us, %zu detours kept\n", capture * 1e6 / CAPTURES, hyperlanes.getDetourCount());
+        std::printf("    lookup after   %10.3f us/route\n", detour * 1e6 / (LOOKUPS / 10));
+    }
+}
+
+int main() {
+    std::printf("Hyperlane benchmark\n");
+    runSize(1000);
+    runSize(10000);
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Per-tick cost of mid-flight interception: both sweeps of the flight table, the grid broadphase over the end
+// positions and the swept narrowphase on the opposing pairs it finds.
+// Two armies fly through each other on interleaved lanes, close enough for every drone to have opposing neighbours
+// in its cells but never close enough to touch, so the drone count stays the same while measuring.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "Game/GameEntityManager.hpp"
+#include "Components/DroneComponent.hpp"
+#include "Components/GameStateComponent.hpp"
+#include "Systems/InterceptionSystem.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr float TICK_DT = 1.f / 60.f;
+    const float LANE_SPACING = Config::INTERCEPT_RADIUS * 3.f;
+
+    // Average milliseconds per call over enough repetitions to run at least minSeconds
+    double measure(const std::function<void()>& tick, double minSeconds = 0.25) {
+        tick(); // warm up
+        int repetitions = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            tick();
+            repetitions++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed * 1000.0 / repetitions;
+    }
+
+    void runSize(size_t droneCount) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> start(0.f, float(Config::MAP_WIDTH));
+        int lanes = static_cast<int>(Config::MAP_HEIGHT / LANE_SPACING);
+        std::uniform_int_distribution<int> lane(0, lanes - 1);
+
+        Game::GameEntityManager entityManager;
+        EntityID stateID = entityManager.createEntity();
+        entityManager.addComponent(stateID, Components::GameStateComponent{2});
+
+        for (size_t i = 0; i < droneCount; ++i) {
+            // Player 1 flies right on even lanes, player 2 left on odd ones
+            bool right = i % 2 == 0;
+            float y = (lane(gen) * 2 + (right ? 0 : 1)) * LANE_SPACING * 0.5f;
+            float x = start(gen);
+            sf::Vector2f from(x, y);
+            sf::Vector2f to(right ? x + 100000.f : x - 100000.f, y);
+
+            EntityID droneID = entityManager.createEntity();
+            entityManager.addComponent(droneID, Components::DroneComponent{""});
+            entityManager.addComponent(droneID, Components::MoveComponent{Config::DRONE_SPEED, 0.f});
+            entityManager.addComponent(droneID, Components::FactionComponent{right ? Components::Faction::PLAYER_1 : Components::Faction::PLAYER_2});
+            entityManager.addComponent(droneID, Components::AttackOrderComponent{0, 0});
+            entityManager.registerUnit(droneID);
+            entityManager.getComponent<Components::MoveComponent>(droneID)->launch(from, to, 0.f);
+            entityManager.addFlight(droneID);
+        }
+
+        double ms = measure([&]() {
+            entityManager.advanceTime();
+            Systems::InterceptionSystem(entityManager, TICK_DT);
+        });
+        std::printf("%9zu drones %10.3f ms/tick %8.2f ns/drone, %zu left\n", droneCount, ms, ms * 1e6 / droneCount, entityManager.getFlights().size());
+    }
+}
+
+int main() {
+    std::printf("Interception benchmark, opposing lanes %.0f px apart\n", LANE_SPACING * 0.5f);
+    runSize(10000);
+    runSize(50000);
+    runSize(100000);
+    return 0;
+}
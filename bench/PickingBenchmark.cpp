@@ -0,0 +1,77 @@
+// Mouse picking on a map of generated-map density, 40 structures, with a growing number of drones in flight.
+// The scan tests every entity's bounds the way hover and click resolution used to, drones included,
+// the picking grid only holds the structures and reads the cell under the mouse.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Game/PickingGrid.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr size_t STRUCTURES = 40;
+    constexpr size_t QUERIES = 100000;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void runSize(size_t droneCount) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+
+        // Structures first, then the drones, the scan only accepts the structures
+        std::vector<sf::FloatRect> bounds;
+        Game::PickingGrid picking;
+        for (size_t i = 0; i < STRUCTURES; ++i) {
+            sf::FloatRect rect(coordX(gen), coordY(gen), float(Config::FACTORY_SIZE), float(Config::FACTORY_SIZE));
+            bounds.push_back(rect);
+            picking.insert(i + 1, rect, Game::PickingGrid::HOVERABLE | Game::PickingGrid::SELECTABLE);
+        }
+        for (size_t i = 0; i < droneCount; ++i) {
+            bounds.emplace_back(coordX(gen), coordY(gen), Config::DRONE_LENGTH * 2.f, Config::DRONE_LENGTH * 2.f);
+        }
+
+        std::vector<sf::Vector2f> points;
+        for (size_t i = 0; i < QUERIES; ++i) {
+            points.emplace_back(coordX(gen), coordY(gen));
+        }
+
+        size_t scanHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (auto& point : points) {
+            for (size_t i = 0; i < bounds.size(); ++i) {
+                if (bounds[i].contains(point)) {
+                    scanHits += i < STRUCTURES;
+                    if (i < STRUCTURES) {
+                        break;
+                    }
+                }
+            }
+        }
+        double scan = secondsSince(start);
+
+        size_t gridHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (auto& point : points) {
+            gridHits += picking.pick(point, Game::PickingGrid::HOVERABLE) != 0;
+        }
+        double grid = secondsSince(start);
+
+        std::printf("%9zu drones  scan %10.3f us  grid %8.3f us per pick, %zu / %zu hits\n",
+                    droneCount, scan * 1e6 / QUERIES, grid * 1e6 / QUERIES, scanHits, gridHits);
+    }
+}
+
+int main() {
+    std::printf("Picking benchmark, %zu structures, %.0f px cells\n", STRUCTURES, Config::PICKING_CELL_SIZE);
+    runSize(0);
+    runSize(1000);
+    runSize(10000);
+    runSize(100000);
+    return 0;
+}
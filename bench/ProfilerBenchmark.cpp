@@ -0,0 +1,84 @@
+// Cost of the frame profiler on a frame with as many zones as the game records at 4x speed: the update,
+// render and HUD zones, ten zones per simulation step and one per map tile searched for contacts.
+// Disabled, as while the overlay is hidden, every zone is one relaxed load. Enabled, every zone reads the clock
+// twice and the frame ends with draining and summing the rings. Both are given as a share of a 60 fps frame.
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "Utils/Profiler.hpp"
+
+namespace {
+
+    constexpr int FRAMES = 2000;
+    constexpr int STEPS_PER_FRAME = 4;
+    constexpr int TILES = 40;
+    constexpr double FRAME_MS = 1000.0 / 60.0;
+
+    const char* const INTERCEPTION = "Interception";
+    const char* const STEP_ZONES[] = {"Timers", "Transfers", INTERCEPTION, "Regions", "Combat", "Rewind", "Hash"};
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Zones of one frame, nested the way the game opens them
+    int runFrame() {
+        int zones = 0;
+        Utils::ProfileZone update("Update");
+        {
+            Utils::ProfileZone simulation("Simulation");
+            for (int step = 0; step < STEPS_PER_FRAME; ++step) {
+                Utils::ProfileZone stepZone("Step");
+                for (const char* name : STEP_ZONES) {
+                    Utils::ProfileZone zone(name);
+                    if (name == INTERCEPTION) {
+                        for (int tile = 0; tile < TILES; ++tile) {
+                            Utils::ProfileZone contacts("Contacts");
+                            zones++;
+                        }
+                    }
+                    zones++;
+                }
+                zones++;
+            }
+            zones++;
+        }
+        {
+            Utils::ProfileZone hud("HUD");
+            zones++;
+        }
+        return zones + 1;
+    }
+
+    double runFrames(bool enabled, int& zonesPerFrame) {
+        auto& profiler = Utils::Profiler::getInstance();
+        profiler.setEnabled(enabled);
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            zonesPerFrame = runFrame();
+            profiler.endFrame();
+        }
+        return secondsSince(start) * 1000.0 / FRAMES;
+    }
+}
+
+int main() {
+    int zonesPerFrame = 0;
+    runFrames(false, zonesPerFrame);   // Warm up
+    double disabled = runFrames(false, zonesPerFrame);
+    double enabled = runFrames(true, zonesPerFrame);
+
+    auto& profiler = Utils::Profiler::getInstance();
+    std::vector<Utils::Profiler::ZoneStats> zones;
+    profiler.getStats(zones);
+
+    std::printf("Profiler benchmark, %d zones per frame, %zu distinct, %llu dropped\n",
+                zonesPerFrame, zones.size(), static_cast<unsigned long long>(profiler.getDroppedSamples()));
+    std::printf("disabled %8.2f us per frame, %6.3f%% of a 60 fps frame, %6.2f ns per zone\n",
+                disabled * 1000.0, disabled * 100.0 / FRAME_MS, disabled * 1e6 / zonesPerFrame);
+    std::printf("enabled  %8.2f us per frame, %6.3f%% of a 60 fps frame, %6.2f ns per zone\n",
+                enabled * 1000.0, enabled * 100.0 / FRAME_MS, enabled * 1e6 / zonesPerFrame);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// "Opponents' strength within R" around every structure of a generated-size map, with a growing number of drones in flight.
+// The scan adds up every structure and drone of the other factions within the radius, the region tree adds up the nodes
+// inside the circle and only looks into the cells on its border. Moving the drones to the cells they fly over
+// is the per-tick cost of keeping the tree up to date.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Game/RegionTree.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr size_t STRUCTURES = 40;
+    constexpr int PASSES = 20;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Components::Faction getFaction(size_t i) {
+        return Components::getPlayerFaction(1 + i % 4);
+    }
+
+    void runSize(size_t droneCount) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+        std::uniform_real_distribution<float> step(-2.f, 2.f);
+
+        Game::RegionTree regions;
+        std::vector<sf::Vector2f> structures;
+        for (size_t i = 0; i < STRUCTURES; ++i) {
+            structures.emplace_back(coordX(gen), coordY(gen));
+            regions.setStructure(i + 1, structures.back(), getFaction(i), 20, 10, 5.f, 0.f, 10.f, 1.f);
+        }
+        std::vector<sf::Vector2f> drones;
+        std::vector<Game::RegionTree::Cell> cells;
+        for (size_t i = 0; i < droneCount; ++i) {
+            drones.emplace_back(coordX(gen), coordY(gen));
+            cells.push_back(regions.getCell(drones.back()));
+            regions.addDrone(getFaction(i), cells.back());
+        }
+
+        // One tick of flight, a drone moves about 2 px
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            for (size_t i = 0; i < droneCount; ++i) {
+                drones[i] += sf::Vector2f(step(gen), step(gen));
+                auto cell = regions.getCell(drones[i]);
+                regions.moveDrone(getFaction(i), cells[i], cell);
+                cells[i] = cell;
+            }
+        }
+        double update = secondsSince(start);
+
+        const float radiusSquared = Config::STRENGTH_RADIUS * Config::STRENGTH_RADIUS;
+        unsigned long scanDrones = 0;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            for (size_t s = 0; s < STRUCTURES; ++s) {
+                for (size_t i = 0; i < STRUCTURES; ++i) {
+                    sf::Vector2f delta = structures[i] - structures[s];
+                    if (getFaction(i) != getFaction(s) && delta.x * delta.x + delta.y * delta.y <= radiusSquared) {
+                        scanDrones += 20;
+                    }
+                }
+                for (size_t i = 0; i < droneCount; ++i) {
+                    sf::Vector2f delta = drones[i] - structures[s];
+                    if (getFaction(i) != getFaction(s) && delta.x * delta.x + delta.y * delta.y <= radiusSquared) {
+                        scanDrones++;
+                    }
+                }
+            }
+        }
+        double scan = secondsSince(start);
+
+        unsigned long treeDrones = 0;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            for (size_t s = 0; s < STRUCTURES; ++s) {
+                auto mask = Game::RegionTree::ALL_FACTIONS & ~Game::RegionTree::getMask(getFaction(s));
+                treeDrones += regions.query(structures[s], Config::STRENGTH_RADIUS, mask, 1.f).getDrones();
+            }
+        }
+        double tree = secondsSince(start);
+
+        std::printf("%7zu drones  update %8.3f ms per tick  scan %9.3f us  tree %7.3f us per query, %lu / %lu drones\n",
+                    droneCount, update * 1000.0 / PASSES, scan * 1e6 / (PASSES * STRUCTURES), tree * 1e6 / (PASSES * STRUCTURES),
+                    scanDrones / PASSES, treeDrones / PASSES);
+    }
+}
+
+int main() {
+    std::printf("Region tree benchmark, %zu structures, %.0f px cells, %.0f px radius\n", STRUCTURES, Config::REGION_CELL_SIZE, Config::STRENGTH_RADIUS);
+    runSize(0);
+    runSize(1000);
+    runSize(10000);
+    runSize(100000);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Per-tick cost of the flight work split over worker threads, from 1 to 32: both sweeps and the per-tile contact search
+// of the interception system with the tile hand-over, then the drawn positions and flocking of the movement system.
+// Drones fly between random points of the map in many fleets, opposing drones meet and destroy each other, so the
+// drones left and their hash show whether the outcome depends on the number of threads.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Game/GameEntityManager.hpp"
+#include "Components/DroneComponent.hpp"
+#include "Components/GameStateComponent.hpp"
+#include "Systems/InterceptionSystem.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr float TICK_DT = 1.f / 60.f;
+    constexpr int TICKS = 120;
+    constexpr std::uint32_t FLEETS = 64;
+
+    void runThreads(size_t droneCount, unsigned int threads) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+
+        Game::GameEntityManager entityManager;
+        entityManager.getWorkers().setThreadCount(threads);
+        EntityID stateID = entityManager.createEntity();
+        entityManager.addComponent(stateID, Components::GameStateComponent{2});
+
+        for (size_t i = 0; i < droneCount; ++i) {
+            sf::Vector2f from(coordX(gen), coordY(gen));
+            sf::Vector2f to(coordX(gen), coordY(gen));
+            EntityID droneID = entityManager.createEntity();
+            entityManager.addComponent(droneID, Components::DroneComponent{""});
+            entityManager.addComponent(droneID, Components::MoveComponent{Config::DRONE_SPEED, 0.f});
+            entityManager.addComponent(droneID, Components::FactionComponent{i % 2 == 0 ? Components::Faction::PLAYER_1 : Components::Faction::PLAYER_2});
+            entityManager.addComponent(droneID, Components::AttackOrderComponent{i % FLEETS, 0});
+            entityManager.registerUnit(droneID);
+            entityManager.getComponent<Components::MoveComponent>(droneID)->launch(from, to, 0.f);
+            entityManager.addFlight(droneID);
+        }
+
+        auto& flights = entityManager.getFlights();
+        auto& workers = entityManager.getWorkers();
+        const sf::FloatRect view(0.f, 0.f, float(Config::SCREEN_WIDTH), float(Config::SCREEN_HEIGHT));
+        double interception = 0.0;
+        double movement = 0.0;
+        for (int tick = 0; tick < TICKS; ++tick) {
+            auto start = std::chrono::steady_clock::now();
+            entityManager.advanceTime();
+            Systems::InterceptionSystem(entityManager, TICK_DT);
+            auto middle = std::chrono::steady_clock::now();
+            flights.evaluate(entityManager.getTime(), view, &workers);
+            flights.flock(entityManager.getTime(), &workers);
+            auto end = std::chrono::steady_clock::now();
+            interception += std::chrono::duration<double>(middle - start).count();
+            movement += std::chrono::duration<double>(end - middle).count();
+        }
+        std::printf("%4u threads %10.3f ms interception %10.3f ms movement per tick, %zu left, hash %016llx\n",
+                    threads, interception * 1000.0 / TICKS, movement * 1000.0 / TICKS, flights.size(),
+                    static_cast<unsigned long long>(entityManager.getDroneHash()));
+    }
+}
+
+int main() {
+    std::printf("Sharding benchmark, %.0f px tiles, %u hardware threads\n", Config::SHARD_TILE_SIZE, std::thread::hardware_concurrency());
+    for (size_t droneCount : {10000, 50000}) {
+        std::printf("%zu drones, %d ticks\n", droneCount, TICKS);
+        for (unsigned int threads : {1, 2, 4, 8, 16, 32}) {
+            runThreads(droneCount, threads);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Target search of one AI perception pass on maps of growing size, a quarter of the structures held by the AI.
+// The scan measures every AI structure against every structure into an ordered map the way perception used to,
+// the index asks for the closest other players' and neutral structures within the attack distance.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "Game/StructureIndex.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr int PASSES = 20;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void runSize(size_t structureCount) {
+        std::mt19937 gen(42);
+        // Generated-map density, the map grows with the structure count
+        float scale = std::sqrt(structureCount / 40.f);
+        std::uniform_real_distribution<float> coordX(0.f, Config::MAP_WIDTH * scale);
+        std::uniform_real_distribution<float> coordY(0.f, Config::MAP_HEIGHT * scale);
+
+        std::vector<sf::Vector2f> positions;
+        std::vector<Components::Faction> factions;
+        Game::StructureIndex structures;
+        for (size_t i = 0; i < structureCount; ++i) {
+            positions.emplace_back(coordX(gen), coordY(gen));
+            factions.push_back(i % 4 == 0 ? Components::Faction::PLAYER_2 : i % 4 == 1 ? Components::Faction::PLAYER_1 : Components::Faction::NEUTRAL);
+            structures.addStructure(i + 1, positions.back(), factions.back());
+        }
+        const auto aiFaction = Components::Faction::PLAYER_2;
+        const float maxDistance = Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK;
+
+        size_t scanTargets = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            std::map<EntityID, std::map<float, EntityID>> byDistance;
+            for (size_t ai = 0; ai < structureCount; ++ai) {
+                if (factions[ai] != aiFaction) {
+                    continue;
+                }
+                for (size_t target = 0; target < structureCount; ++target) {
+                    if (factions[target] == aiFaction) {
+                        continue;
+                    }
+                    sf::Vector2f delta = positions[target] - positions[ai];
+                    byDistance[ai + 1][std::sqrt(delta.x * delta.x + delta.y * delta.y)] = target + 1;
+                }
+            }
+            for (auto& [id, targets] : byDistance) {
+                scanTargets += std::distance(targets.begin(), targets.upper_bound(maxDistance));
+            }
+        }
+        double scan = secondsSince(start);
+
+        size_t indexTargets = 0;
+        std::vector<Game::StructureIndex::Neighbour> targets;
+        auto notAI = [aiFaction](EntityID, Components::Faction faction) { return faction != aiFaction; };
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            for (size_t ai = 0; ai < structureCount; ++ai) {
+                if (factions[ai] != aiFaction) {
+                    continue;
+                }
+                structures.nearest(positions[ai], Config::AI_TARGETS_PER_GARRISON, maxDistance, notAI, targets);
+                indexTargets += targets.size();
+            }
+        }
+        double index = secondsSince(start);
+
+        std::printf("%7zu structures  scan %10.3f ms  index %8.3f ms per pass, %zu / %zu targets in range\n",
+                    structureCount, scan * 1000.0 / PASSES, index * 1000.0 / PASSES, scanTargets / PASSES, indexTargets / PASSES);
+    }
+}
+
+int main() {
+    std::printf("Structure index benchmark, %u closest targets within %.0f px\n", Config::AI_TARGETS_PER_GARRISON, Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK);
+    runSize(40);
+    runSize(400);
+    runSize(4000);
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Per-frame cost of the fog of war: every drone's fog cell is recomputed, the few that crossed a cell boundary
+// move their occupancy count, and the visible rows of the factions whose occupancy changed are rebuilt
+// with word-parallel dilation. A full recount of every drone is shown for comparison.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "Game/Visibility.hpp"
+#include "Config.hpp"
+
+namespace {
+
+    constexpr float FRAME_DT = 1.f / 60.f;
+    constexpr unsigned int PLAYERS = 8;
+
+    // Average milliseconds per call over enough repetitions to run at least minSeconds
+    double measure(const std::function<void()>& frame, double minSeconds = 0.25) {
+        frame(); // warm up
+        int repetitions = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            frame();
+            repetitions++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed * 1000.0 / repetitions;
+    }
+
+    struct Drones {
+        std::vector<float> x, y, dx, dy;
+        std::vector<Components::Faction> faction;
+        std::vector<Game::Visibility::Cell> cell;
+
+        // Fly straight, bouncing off the map edges
+        void move() {
+            for (size_t i = 0; i < x.size(); ++i) {
+                x[i] += dx[i] * FRAME_DT;
+                y[i] += dy[i] * FRAME_DT;
+                if (x[i] < 0.f || x[i] > Config::MAP_WIDTH) dx[i] = -dx[i];
+                if (y[i] < 0.f || y[i] > Config::MAP_HEIGHT) dy[i] = -dy[i];
+            }
+        }
+    };
+
+    void runSize(size_t droneCount) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> coordX(0.f, float(Config::MAP_WIDTH));
+        std::uniform_real_distribution<float> coordY(0.f, float(Config::MAP_HEIGHT));
+        std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+        Game::Visibility visibility;
+        Drones drones;
+        for (size_t i = 0; i < droneCount; ++i) {
+            float a = angle(gen);
+            drones.x.push_back(coordX(gen));
+            drones.y.push_back(coordY(gen));
+            drones.dx.push_back(std::cos(a) * Config::DRONE_SPEED);
+            drones.dy.push_back(std::sin(a) * Config::DRONE_SPEED);
+            drones.faction.push_back(Components::getPlayerFaction(1 + i % PLAYERS));
+            drones.cell.push_back(visibility.getCell({drones.x[i], drones.y[i]}));
+            visibility.addDrone(drones.faction[i], drones.cell[i]);
+        }
+        for (unsigned int player = 1; player <= PLAYERS; ++player) {
+            visibility.setStructure(player, {coordX(gen), coordY(gen)}, Components::getPlayerFaction(player));
+        }
+        visibility.update();
+
+        std::printf("%9zu drones, %u players\n", droneCount, PLAYERS);
+        double incremental = measure([&]() {
+            drones.move();
+            for (size_t i = 0; i < droneCount; ++i) {
+                auto cell = visibility.getCell({drones.x[i], drones.y[i]});
+                if (cell != drones.cell[i]) {
+                    visibility.moveDrone(drones.faction[i], drones.cell[i], cell);
+                    drones.cell[i] = cell;
+                }
+            }
+            visibility.update();
+        });
+        double recount = measure([&]() {
+            drones.move();
+            for (size_t i = 0; i < droneCount; ++i) {
+                visibility.removeDrone(drones.faction[i], drones.cell[i]);
+            }
+            for (size_t i = 0; i < droneCount; ++i) {
+                drones.cell[i] = visibility.getCell({drones.x[i], drones.y[i]});
+                visibility.addDrone(drones.faction[i], drones.cell[i]);
+            }
+            visibility.update();
+        });
+        double movement = measure([&]() { drones.move(); });
+        std::printf("    incremental    %10.3f ms/frame %8.2f ns/drone\n", incremental - movement, (incremental - movement) * 1e6 / droneCount);
+        std::printf("    full recount   %10.3f ms/frame %8.2f ns/drone\n", recount - movement, (recount - movement) * 1e6 / droneCount);
+    }
+}
+
+int main() {
+    std::printf("Fog of war benchmark, %d x %d cells\n", Game::Visibility::COLUMNS, Game::Visibility().getRows());
+    runSize(10000);
+    runSize(100000);
+    return 0;
+}
@@ -7,6 +7,9 @@
 #include <vector>
 #include <set>
 
+#include "Core/TimerWheel.hpp"
+#include "Components/FactionComponent.hpp"
+
 namespace Components {
 
     namespace AI{
@@ -40,6 +43,7 @@ namespace Components {
             };
     }
     
+    // "ai" is the faction the AI plays, "player" every other player together
     struct AIPerception {
         unsigned int aiTotalDrones = 0;
         unsigned int aiTotalEnergy = 0;
@@ -54,9 +58,10 @@ namespace Components {
         sf::Vector2f aiCentralPosition;
 
         std::unordered_map<EntityID, unsigned int> garissonByDroneCount;
-        std::unordered_map<EntityID, std::map<float, EntityID>> garissonsByDistance;
-        std::unordered_set<EntityID> playerGarissons;
-        std::unordered_set<EntityID> aiGarissons;
+        std::unordered_map<EntityID, std::vector<std::pair<float, EntityID>>> garissonsByDistance;  // Closest first
+        std::unordered_map<EntityID, unsigned int> threatByGarisson;   // Opponents' drones in flight nearby
+        std::vector<EntityID> playerGarissons;   // In garrison list order, plans must not depend on hash table history
+        std::vector<EntityID> aiGarissons;
 
         void reset(){
             aiTotalDrones = 0;
@@ -71,6 +76,7 @@ namespace Components {
 
             garissonByDroneCount.clear();
             garissonsByDistance.clear();
+            threatByGarisson.clear();
 
             playerGarissons.clear();
             aiGarissons.clear();
@@ -104,7 +110,9 @@ namespace Components {
     };
 
     struct AIComponent {
+        Faction faction = Faction::PLAYER_2; // Computer player driven by this AI
         EntityID highlightedEntityID = 0;
+        TimerID decisionTimerID = 0; // One-shot timer of the next AI turn, shared by every AI
         AIPerception perception;
         AIPlan plan;
         AIExecute execute;
@@ -116,6 +124,8 @@ namespace Components {
             execute.reset();
             debug.reset();
         }
+
+        AIComponent(Faction faction = Faction::PLAYER_2) : faction(faction) {}
     };
 }
 
@@ -8,8 +8,9 @@ namespace Components {
         EntityID origin;
         EntityID target;
         bool isActivated = false;
+        double waveTime = 0.0;  // Start of the wave a drone left in, the drones of one wave flock together
 
-        AttackOrderComponent(EntityID origin, EntityID target) : origin(origin), target(target), isActivated(false) {}
+        AttackOrderComponent(EntityID origin, EntityID target, double waveTime = 0.0) : origin(origin), target(target), isActivated(false), waveTime(waveTime) {}
     };
 }
 
@@ -2,6 +2,8 @@
 #define FACTION_COMPONENT_HPP
 
 #include <string> 
+#include <array>
+#include <cstddef>
 
 #include <sfml/Graphics.hpp>
 
@@ -10,13 +12,77 @@ namespace Components {
         NEUTRAL = 0,
         PLAYER_1 = 1,
         PLAYER_2 = 2,
-        PLAYER_3 = 3
+        PLAYER_3 = 3,
+        PLAYER_4 = 4,
+        PLAYER_5 = 5,
+        PLAYER_6 = 6,
+        PLAYER_7 = 7,
+        PLAYER_8 = 8,
+        PLAYER_9 = 9,
+        PLAYER_10 = 10,
+        PLAYER_11 = 11,
+        PLAYER_12 = 12,
+        PLAYER_13 = 13,
+        PLAYER_14 = 14,
+        PLAYER_15 = 15,
+        PLAYER_16 = 16
     };
 
+    constexpr unsigned int MAX_PLAYERS = 16;
+    constexpr size_t FACTION_COUNT = MAX_PLAYERS + 1; // Players and the neutral faction
+
+    // Faction of the player at this screen, the others are played by the AI
+    constexpr Faction LOCAL_PLAYER = Faction::PLAYER_1;
+
+    // Player 1 is Faction::PLAYER_1
+    constexpr Faction getPlayerFaction(unsigned int player) {
+        return static_cast<Faction>(player);
+    }
+
+    // Per-faction values in a dense array indexed by the faction
+    template<typename T>
+    struct PerFaction {
+        std::array<T, FACTION_COUNT> values{};
+
+        T& operator[](Faction faction) { return values[static_cast<size_t>(faction)]; }
+        const T& operator[](Faction faction) const { return values[static_cast<size_t>(faction)]; }
+
+        void fill(const T& value) { values.fill(value); }
+    };
+
+    struct FactionStyle {
+        const char* name;
+        sf::Color color;
+    };
+
+    // Names and colours shown for each faction
+    inline const FactionStyle& getFactionStyle(Faction faction) {
+        static const std::array<FactionStyle, FACTION_COUNT> styles = {{
+            {"Neutral", sf::Color(100, 100, 100)},
+            {"Player 1", sf::Color::Red},
+            {"Player 2", sf::Color::Blue},
+            {"Player 3", sf::Color(40, 180, 60)},
+            {"Player 4", sf::Color(230, 200, 30)},
+            {"Player 5", sf::Color(160, 60, 200)},
+            {"Player 6", sf::Color(240, 130, 20)},
+            {"Player 7", sf::Color(30, 200, 200)},
+            {"Player 8", sf::Color(240, 100, 180)},
+            {"Player 9", sf::Color(130, 80, 40)},
+            {"Player 10", sf::Color(150, 220, 90)},
+            {"Player 11", sf::Color(90, 120, 240)},
+            {"Player 12", sf::Color(200, 40, 90)},
+            {"Player 13", sf::Color(240, 240, 240)},
+            {"Player 14", sf::Color(120, 130, 60)},
+            {"Player 15", sf::Color(250, 180, 140)},
+            {"Player 16", sf::Color(60, 110, 110)},
+        }};
+        return styles[static_cast<size_t>(faction) < FACTION_COUNT ? static_cast<size_t>(faction) : 0];
+    }
+
     struct FactionComponent {
         Faction faction = Faction::NEUTRAL;
         FactionComponent(Faction id = Faction::NEUTRAL) : faction(id) {}
     };
 }
 
-#endif
\ No newline at end of file
+#endif
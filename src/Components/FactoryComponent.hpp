@@ -4,11 +4,13 @@
 #include <string>
 #include <unordered_set>
 
+#include "Core/TimerWheel.hpp"
+
 namespace Components {
     struct FactoryComponent {
         std::string factoryName;
         float droneProductionRate = 0.1f;
-        float productionTimer = 0.f;
+        TimerID productionTimerID = 0; // Periodic timer producing the next drone, set once the factory has an owner
 
         FactoryComponent(const std::string& factoryName) : factoryName(factoryName) {}
         FactoryComponent(const std::string& factoryName, float droneProductionRate) : factoryName(factoryName), droneProductionRate(droneProductionRate) {}
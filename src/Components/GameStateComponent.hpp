@@ -1,35 +1,53 @@
 #ifndef GAME_STATE_COMPONENT_HPP
 #define GAME_STATE_COMPONENT_HPP
 
-#include <unordered_map>
+#include <cstdint>
 #include "Components/FactionComponent.hpp"
 
 namespace Components {
     struct GameStateComponent {
-        std::unordered_map<Faction, int> playerDrones;
-        std::unordered_map<Faction, int> playerEnergy;
+        // Per-faction aggregates, kept up to date by the GameEntityManager on spawn, death and ownership changes
+        PerFaction<int> playerEnergy;     // Energy capacity of the owned power plants
+        PerFaction<int> structureCount;   // Owned factories and power plants
+        PerFaction<int> garrisonedDrones; // Drones parked at owned structures
+        PerFaction<int> inFlightDrones;   // Drones launched and not yet arrived
+        unsigned int playerCount = 0;     // Players 1 to playerCount take part
         Faction winner = Faction::NEUTRAL;
         bool isGameOver = false;
+        std::uint64_t tick = 0; // Fixed steps taken
+        double time = 0.0;      // Simulation clock in seconds, tick * SIMULATION_STEP_SEC so it never drifts
 
-        GameStateComponent(unsigned int playerCount) {
-            if(playerCount == 1){
-                playerDrones[Faction::PLAYER_1] = 0;
-                playerEnergy[Faction::PLAYER_1] = 0;
-            }
-            else if(playerCount == 2){
-                playerDrones[Faction::PLAYER_1] = 0;
-                playerDrones[Faction::PLAYER_2] = 0;
-                playerEnergy[Faction::PLAYER_1] = 0;
-                playerEnergy[Faction::PLAYER_2] = 0;
-            }
+        GameStateComponent(unsigned int playerCount) : playerCount(playerCount < MAX_PLAYERS ? playerCount : MAX_PLAYERS) {}
+
+        int getDroneCount(Faction faction) const {
+            return garrisonedDrones[faction] + inFlightDrones[faction];
         }
 
-        void ClearAllEnergy(){
-            for(auto& [id, energy] : playerEnergy){
-                energy = 0;
+        // A player without structures and without drones in flight is out
+        bool isAlive(Faction faction) const {
+            return structureCount[faction] + inFlightDrones[faction] > 0;
+        }
+
+        // The game ends once at most one player is left, or the only player is out.
+        void updateGameOver() {
+            if (isGameOver) {
+                return;
+            }
+            unsigned int alive = 0;
+            Faction lastAlive = Faction::NEUTRAL;
+            for (unsigned int i = 1; i <= playerCount; ++i) {
+                Faction faction = getPlayerFaction(i);
+                if (isAlive(faction)) {
+                    alive++;
+                    lastAlive = faction;
+                }
+            }
+            if (alive == 0 || (playerCount > 1 && alive == 1)) {
+                winner = alive == 1 ? lastAlive : Faction::NEUTRAL;
+                isGameOver = true;
             }
         }
     };
 }
 
-#endif // GAME_STATE_COMPONENT_HPP
\ No newline at end of file
+#endif // GAME_STATE_COMPONENT_HPP
@@ -0,0 +1,33 @@
+#ifndef LAUNCH_COMPONENT_HPP
+#define LAUNCH_COMPONENT_HPP
+
+#include <cmath>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+
+namespace Components {
+
+    // An attack wave leaving a structure as a stream of drones rather than all in one tick.
+    // The stream may launch floor(rate * (time - startTime)) + 1 drones by a given time, ticks that ran out of
+    // launch budget catch up later.
+    struct LaunchComponent {
+        EntityID target;
+        Faction faction;            // Owner that placed the order, the wave stops on capture
+        unsigned int waveSize;      // Drones in the wave when the order was placed, sets the launch spread
+        unsigned int remaining;     // Drones still to launch
+        unsigned int launched = 0;
+        double startTime;
+
+        LaunchComponent(EntityID target, Faction faction, unsigned int waveSize, double startTime)
+            : target(target), faction(faction), waveSize(waveSize), remaining(waveSize), startTime(startTime) {}
+
+        // Drones the stream may launch at this time
+        unsigned int getAllowance(double time, float rate) const {
+            float due = std::floor(static_cast<float>(std::max(time - startTime, 0.0)) * rate) + 1.f;
+            return due > static_cast<float>(launched) ? static_cast<unsigned int>(due) - launched : 0;
+        }
+    };
+}
+
+#endif // LAUNCH_COMPONENT_HPP
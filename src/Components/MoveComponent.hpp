@@ -2,6 +2,12 @@
 #define MOVE_COMPONENT_HPP
 
 #include <SFML/Graphics.hpp>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Config.hpp"
 
 namespace Components {
     struct MoveComponent {
@@ -10,14 +16,126 @@ namespace Components {
         sf::Vector2f targetPosition; // Optional target position
         bool moveToTarget = false;   // Flag to enable movement to target
 
+        // Flights at constant speed are evaluated in closed form, one straight leg at a time:
+        // position = legStart + direction * speed * (time - legStartTime)
+        sf::Vector2f launchPosition;
+        double launchTime = 0.0;
+        double arrivalTime = 0.0;     // Known at launch, used by the arrival queue
+
+        // Corners around structures after the launch position, ending at the target.
+        // Shared by the drones taking the same route, null for a straight flight.
+        std::shared_ptr<const std::vector<sf::Vector2f>> route;
+
+        // Current leg
+        size_t leg = 0;
+        sf::Vector2f legStart;
+        sf::Vector2f legEnd;
+        double legStartTime = 0.0;
+        double legEndTime = 0.0;
+        sf::Vector2f direction;      // Unit vector along the leg
+        float heading = 0.f;         // Rotation (degrees) aligning the triangle tip with the direction
+
+        bool isOnScreen = false;     // Set by the MovementSystem when the position was evaluated for rendering
+
         MoveComponent() = default;
 
         MoveComponent(float speed, float angularVelocity)
             : speed(speed), angularVelocity(angularVelocity), moveToTarget(false) {}
 
         MoveComponent(const sf::Vector2f& target, float speed, float angularVelocity)
-            : moveToTarget(true), speed(speed), angularVelocity(angularVelocity), targetPosition(target) {}    
+            : moveToTarget(true), speed(speed), angularVelocity(angularVelocity), targetPosition(target) {}
+
+        // Start a flight towards target, straight or through the corners of a route, returns the arrival time
+        double launch(const sf::Vector2f& from, const sf::Vector2f& target, double time, std::shared_ptr<const std::vector<sf::Vector2f>> route = nullptr) {
+            launchPosition = from;
+            targetPosition = target;
+            launchTime = time;
+            this->route = std::move(route);
+
+            float distance = 0.f;
+            sf::Vector2f previous = from;
+            for (size_t i = 0; i < getLegCount(); ++i) {
+                sf::Vector2f delta = getCorner(i) - previous;
+                distance += std::sqrt(delta.x * delta.x + delta.y * delta.y);
+                previous = getCorner(i);
+            }
+
+            arrivalTime = time + getFlightTime(distance, speed);
+
+            setLeg(0, from, time);
+            moveToTarget = true;
+            return arrivalTime;
+        }
+
+        // Time to fly a distance, drones snap to the target once they are within the stopping distance
+        static float getFlightTime(float distance, float speed) {
+            float flightDistance = std::max(0.f, distance - getStoppingDistance(speed));
+            return speed > 0.f ? flightDistance / speed : 0.f;
+        }
+
+        static float getStoppingDistance(float speed) {
+            return std::max(5.0f, speed * 0.1f); // 10% of speed, min 5 pixels
+        }
+
+        size_t getLegCount() const {
+            return route ? route->size() : 1;
+        }
+
+        // End of a leg, the last one ends at the target
+        sf::Vector2f getCorner(size_t index) const {
+            return route ? (*route)[index] : targetPosition;
+        }
+
+        // Turn towards the next corner once the current leg is flown, returns whether the leg changed
+        bool advanceLeg(double time) {
+            bool advanced = false;
+            while (time >= legEndTime && leg + 1 < getLegCount()) {
+                setLeg(leg + 1, legEnd, legEndTime);
+                advanced = true;
+            }
+            return advanced;
+        }
+
+        sf::Vector2f getPosition(double time) const {
+            if (time >= arrivalTime) {
+                return targetPosition;
+            }
+            if (time < legStartTime || time >= legEndTime) {
+                // Not the current leg, fly the route again on a copy
+                MoveComponent flight = *this;
+                flight.setLeg(0, launchPosition, launchTime);
+                flight.advanceLeg(time);
+                return flight.getLegPosition(time);
+            }
+            return getLegPosition(time);
+        }
+
+        float getRotation(double time) const {
+            return heading + angularVelocity * static_cast<float>(std::max(0.0, time - launchTime));
+        }
+
+    private:
+        sf::Vector2f getLegPosition(double time) const {
+            float travelled = speed * static_cast<float>(std::max(0.0, time - legStartTime));
+            return legStart + direction * travelled;
+        }
+
+        void setLeg(size_t index, const sf::Vector2f& start, double startTime) {
+            leg = index;
+            legStart = start;
+            legEnd = getCorner(index);
+            legStartTime = startTime;
+
+            sf::Vector2f delta = legEnd - start;
+            float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            direction = distance > 0.f ? delta / distance : sf::Vector2f(0.f, 0.f);
+            heading = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG + 90.f;
+
+            // The last leg ends with the snap to the target
+            bool last = index + 1 >= getLegCount();
+            legEndTime = last ? arrivalTime : (speed > 0.f ? startTime + distance / speed : startTime);
+        }
     };
 }
 
-#endif // MOVE_COMPONENT_HPP
\ No newline at end of file
+#endif // MOVE_COMPONENT_HPP
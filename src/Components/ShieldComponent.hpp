@@ -1,24 +1,31 @@
 #ifndef SHIELD_COMPONENT_HPP
 #define SHIELD_COMPONENT_HPP
 
+#include <algorithm>
+
 namespace Components {
 
+// Shields regenerate linearly up to maxShield, so only the value at the last change is stored
+// and the current value is evaluated on read: min(maxShield, baseShield + regenRate * (time - baseTime))
 struct ShieldComponent {
-    float currentShield = 0.f;
+    float baseShield = 0.f; // Shield value at baseTime
+    double baseTime = 0.0;  // Simulation time of the last hit
     float maxShield = 10.f;
     float regenRate = 1.f;
-    float regenTimer = 0.f;
 
     ShieldComponent(){}
-    ShieldComponent(float currentShield, float maxShield, float regenRate) : currentShield(currentShield), maxShield(maxShield), regenRate(regenRate) {}
+    ShieldComponent(float currentShield, float maxShield, float regenRate) : baseShield(currentShield), maxShield(maxShield), regenRate(regenRate) {}
 
-    void setShield(float shield) { currentShield = shield; }
-    void incrementShield(float amount = 1.f) { currentShield += amount; }
-    void decrementShield(float amount = 1.f) { currentShield -= amount; }
-    float getShield() const { return currentShield; }
+    float getShield(double time) const {
+        return std::min(maxShield, baseShield + regenRate * static_cast<float>(std::max(time - baseTime, 0.0)));
+    }
+    void setShield(float shield, double time) {
+        baseShield = shield;
+        baseTime = time;
+    }
+    void incrementShield(double time, float amount = 1.f) { setShield(getShield(time) + amount, time); }
+    void decrementShield(double time, float amount = 1.f) { setShield(getShield(time) - amount, time); }
     };
-
-    // TODO: shield as float for smooth rendering
 };
 
-#endif // SHIELD_COMPONENT_HPP
\ No newline at end of file
+#endif // SHIELD_COMPONENT_HPP
@@ -34,6 +34,22 @@ public:
         entities.erase(id);
     }
 
+    // An entity taken out of storage with its components still allocated, see detachEntity()
+    using DetachedEntity = std::unordered_map<EntityID, Entity>::node_type;
+
+    // Take an entity out without destroying it, so it can be brought back later
+    DetachedEntity detachEntity(EntityID id) {
+        return entities.extract(id);
+    }
+
+    // Bring back a detached entity under a new ID, IDs are never reused
+    EntityID attachEntity(DetachedEntity entity) {
+        EntityID id = nextID++;
+        entity.key() = id;
+        entities.insert(std::move(entity));
+        return id;
+    }
+
     // Add a component
     template<typename T>
     void addComponent(EntityID id, T component) {
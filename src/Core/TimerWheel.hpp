@@ -0,0 +1,247 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <vector>
+#include <array>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+using TimerID = std::uint64_t;
+
+// Hierarchical timer wheel: 4 levels of 64 slots.
+// Level 0 holds timers due within 64 ticks, level 1 within 64^2 ticks and so on;
+// timers cascade down a level whenever the lower level wraps around.
+// Advancing only touches the slots of the ticks that elapsed, never the idle timers.
+class TimerWheel {
+public:
+    using Callback = std::function<void(double time)>; // receives the time the timer was due
+
+    explicit TimerWheel(double resolution = 0.01) : resolution(resolution) {}
+
+    // One-shot timer at an absolute time
+    TimerID schedule(double time, Callback callback) {
+        return insert(time, 0.0, std::move(callback));
+    }
+
+    // Periodic timer, first due at an absolute time then every period seconds without drift
+    TimerID schedulePeriodic(double firstTime, double period, Callback callback) {
+        return insert(firstTime, std::max(period, resolution), std::move(callback));
+    }
+
+    // Cancelled timers are dropped lazily when their slot comes up;
+    // slots hold full TimerIDs so a reused slab entry is never mistaken for the old timer
+    bool cancel(TimerID id) {
+        Timer* timer = find(id);
+        if (!timer) {
+            return false;
+        }
+        release(static_cast<std::uint32_t>(id & 0xffffffff));
+        return true;
+    }
+
+    bool isScheduled(TimerID id) const {
+        std::uint32_t index = static_cast<std::uint32_t>(id & 0xffffffff);
+        return index < timers.size() && timers[index].active && timers[index].generation == (id >> 32);
+    }
+
+    // Fire every timer due at or before now, in due time order
+    void advance(double now) {
+        std::int64_t targetTick = toTick(now);
+
+        while (true) {
+            fireSlot(currentTick, now);
+            if (currentTick >= targetTick) {
+                break;
+            }
+            currentTick++;
+            cascade();
+        }
+        time = now;
+    }
+
+    // Time the timer fires next, negative if it is not scheduled
+    double getDueTime(TimerID id) const {
+        return isScheduled(id) ? timers[static_cast<std::uint32_t>(id & 0xffffffff)].dueTime : -1.0;
+    }
+
+    double getTime() const { return time; }
+    size_t size() const { return activeCount; }
+
+    // Drop every timer and restart the wheel at the given time, e.g. after the world was restored
+    void clear(double now = 0.0) {
+        for (auto& level : wheel) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        timers.clear();
+        freeList.clear();
+        activeCount = 0;
+        currentTick = toTick(now);
+        time = now;
+    }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+
+    struct Timer {
+        double dueTime = 0.0;
+        double period = 0.0;
+        std::int64_t dueTick = 0;
+        std::uint32_t generation = 1; // starts at 1 so that TimerID 0 is never valid
+        bool active = false;
+        Callback callback;
+    };
+
+    double resolution;
+    double time = 0.0;
+    std::int64_t currentTick = 0;
+    size_t activeCount = 0;
+
+    std::vector<Timer> timers;           // slab, indexed by the low half of TimerID
+    std::vector<std::uint32_t> freeList;
+    std::array<std::array<std::vector<TimerID>, SLOTS>, LEVELS> wheel;
+    std::vector<TimerID> firing;         // scratch buffer reused across ticks
+
+    std::int64_t toTick(double t) const {
+        return static_cast<std::int64_t>(std::floor(t / resolution));
+    }
+
+    TimerID makeID(std::uint32_t index) const {
+        return (static_cast<TimerID>(timers[index].generation) << 32) | index;
+    }
+
+    Timer* find(TimerID id) {
+        std::uint32_t index = static_cast<std::uint32_t>(id & 0xffffffff);
+        if (index >= timers.size() || !timers[index].active || timers[index].generation != (id >> 32)) {
+            return nullptr;
+        }
+        return &timers[index];
+    }
+
+    TimerID insert(double dueTime, double period, Callback callback) {
+        std::uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(timers.size());
+            timers.emplace_back();
+        }
+
+        Timer& timer = timers[index];
+        timer.dueTime = dueTime;
+        timer.period = period;
+        timer.dueTick = toTick(dueTime);
+        timer.active = true;
+        timer.callback = std::move(callback);
+        activeCount++;
+
+        place(index);
+        return makeID(index);
+    }
+
+    void release(std::uint32_t index) {
+        Timer& timer = timers[index];
+        timer.active = false;
+        timer.callback = nullptr;
+        timer.generation++;
+        activeCount--;
+        freeList.push_back(index);
+    }
+
+    void place(std::uint32_t index) {
+        Timer& timer = timers[index];
+        // Overdue timers fire on the next advance
+        std::int64_t dueTick = std::max(timer.dueTick, currentTick);
+        std::int64_t delta = dueTick - currentTick;
+
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (std::int64_t(1) << (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+        size_t slot = static_cast<size_t>((dueTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+        wheel[level][slot].push_back(makeID(index));
+    }
+
+    // Move timers from a higher level slot down once the lower levels wrapped
+    void cascade() {
+        for (int level = 1; level < LEVELS; ++level) {
+            std::int64_t mask = (std::int64_t(1) << (SLOT_BITS * level)) - 1;
+            if ((currentTick & mask) != 0) {
+                break;
+            }
+            size_t slot = static_cast<size_t>((currentTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+            std::vector<TimerID> pending;
+            pending.swap(wheel[level][slot]);
+            for (auto id : pending) {
+                if (isScheduled(id)) {
+                    place(static_cast<std::uint32_t>(id & 0xffffffff));
+                }
+            }
+        }
+    }
+
+    void fireSlot(std::int64_t tick, double now) {
+        auto& slot = wheel[0][static_cast<size_t>(tick & (SLOTS - 1))];
+        if (slot.empty()) {
+            return;
+        }
+
+        // Take the slot so callbacks can schedule into it without invalidating the loop
+        firing.clear();
+        firing.swap(slot);
+
+        std::vector<std::uint32_t> due;
+        for (auto id : firing) {
+            if (!isScheduled(id)) {
+                continue;
+            }
+            std::uint32_t index = static_cast<std::uint32_t>(id & 0xffffffff);
+            if (timers[index].dueTick <= tick && timers[index].dueTime <= now) {
+                due.push_back(index);
+            } else {
+                slot.push_back(id);
+            }
+        }
+
+        std::sort(due.begin(), due.end(), [this](std::uint32_t a, std::uint32_t b) {
+            if (timers[a].dueTime != timers[b].dueTime) {
+                return timers[a].dueTime < timers[b].dueTime;
+            }
+            return a < b;
+        });
+
+        for (auto index : due) {
+            Timer& timer = timers[index];
+            if (!timer.active) {
+                continue; // cancelled by an earlier callback
+            }
+            double dueTime = timer.dueTime;
+            std::uint32_t generation = timer.generation;
+
+            if (timer.period > 0.0) {
+                // Keep the callback alive while it runs, it may cancel its own timer
+                Callback callback = timer.callback;
+                callback(dueTime);
+
+                Timer& current = timers[index];
+                if (current.active && current.generation == generation) {
+                    current.dueTime = dueTime + current.period;
+                    current.dueTick = toTick(current.dueTime);
+                    place(index);
+                }
+            } else {
+                Callback callback = std::move(timer.callback);
+                release(index);
+                callback(dueTime);
+            }
+        }
+    }
+};
+
+#endif // TIMER_WHEEL_HPP
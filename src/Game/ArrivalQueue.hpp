@@ -0,0 +1,54 @@
+#ifndef ARRIVAL_QUEUE_HPP
+#define ARRIVAL_QUEUE_HPP
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+#include "Core/EntityManager.hpp"
+
+namespace Game {
+
+    // Drones fly in closed form, so their arrival time is known at launch.
+    // The queue hands out arrivals in time order, the CombatSystem only touches drones that landed.
+    class ArrivalQueue {
+    public:
+        struct Arrival {
+            double time;
+            EntityID droneID;
+
+            bool operator>(const Arrival& other) const {
+                if (time != other.time) {
+                    return time > other.time;
+                }
+                return droneID > other.droneID;
+            }
+        };
+
+        void push(EntityID droneID, double arrivalTime) {
+            arrivals.push(Arrival{arrivalTime, droneID});
+        }
+
+        bool hasDue(double time) const {
+            return !arrivals.empty() && arrivals.top().time <= time;
+        }
+
+        Arrival pop() {
+            Arrival arrival = arrivals.top();
+            arrivals.pop();
+            return arrival;
+        }
+
+        size_t size() const { return arrivals.size(); }
+        bool empty() const { return arrivals.empty(); }
+
+        void clear() {
+            arrivals = {};
+        }
+
+    private:
+        std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> arrivals;
+    };
+}
+
+#endif // ARRIVAL_QUEUE_HPP
@@ -17,6 +17,7 @@
 #include "Components/MoveComponent.hpp"
 #include "Components/SelectableComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
 #include "Utils/Logger.hpp"
 #include "Resources/ResourceManager.hpp"
 #include "Config.hpp"
@@ -50,6 +51,7 @@ namespace Game {
         entityManager.addComponent(factoryID, Components::FactionComponent{faction});
         entityManager.addComponent(factoryID, Components::GarissonComponent{});
         entityManager.addComponent(factoryID, Components::ShieldComponent{0, 10, shieldRegenRate});
+        entityManager.registerUnit(factoryID);
         return factoryID;
     }
 
@@ -75,12 +77,29 @@ namespace Game {
 
         float maxShield = energyCapacity;
         entityManager.addComponent(powerPlantID, Components::ShieldComponent{0, maxShield, shieldRegenRate});
+        entityManager.registerUnit(powerPlantID);
         return powerPlantID;
     }
 
     EntityID createDrone(GameEntityManager& entityManager, std::string name = "", Components::Faction faction = Components::Faction::NEUTRAL) {
-        EntityID droneID = entityManager.createEntity();
-        
+        sf::Color color{100,100,100};
+
+        // A pooled drone has every component already, only their values are set again
+        EntityID droneID = entityManager.reuseDrone();
+        if (droneID != 0) {
+            Entity& entity = entityManager.getEntity(droneID);
+            entity.getComponent<Components::DroneComponent>()->droneName = name;
+            *entity.getComponent<Components::TransformComponent>() = Components::TransformComponent{sf::Vector2f(0.f,0.f), 0.f, sf::Vector2f(1, 1)};
+            entity.getComponent<Components::ShapeComponent>()->setFillColor(color);
+            entity.getComponent<Components::LabelComponent>()->setText(name);
+            *entity.getComponent<Components::MoveComponent>() = Components::MoveComponent{Config::DRONE_SPEED, 0.f};
+            entity.getComponent<Components::FactionComponent>()->faction = faction;
+            entityManager.registerUnit(droneID);
+            return droneID;
+        }
+
+        droneID = entityManager.createEntity();
+
         entityManager.addComponent(droneID, Components::DroneComponent{name});
         entityManager.addComponent(droneID, Components::TransformComponent{sf::Vector2f(0.f,0.f), 0.f, sf::Vector2f(1, 1)});
         auto shape = std::make_shared<sf::ConvexShape>();
@@ -89,7 +108,6 @@ namespace Game {
         shape->setPoint(0, sf::Vector2f(0.f, -Config::DRONE_LENGTH));  // Top point
         shape->setPoint(1, sf::Vector2f(-Config::DRONE_LENGTH, Config::DRONE_LENGTH)); // Bottom-left point
         shape->setPoint(2, sf::Vector2f(Config::DRONE_LENGTH, Config::DRONE_LENGTH));  // Bottom-right point
-        sf::Color color{100,100,100};
         shape->setFillColor(color);
         entityManager.addComponent(droneID, Components::ShapeComponent{shape});
         entityManager.addComponent(droneID, Components::LabelComponent{name, 
@@ -101,9 +119,48 @@ namespace Game {
 
         entityManager.addComponent(droneID, Components::MoveComponent{Config::DRONE_SPEED, 0.f});
         entityManager.addComponent(droneID, Components::FactionComponent{faction});
+        entityManager.registerUnit(droneID);
 
         return droneID;
     }
+
+    // Corners of a flight: along the lanes in hyperlane matches, around the structures in the way otherwise
+    std::shared_ptr<const Navigation::Route> findDroneRoute(GameEntityManager& entityManager, Components::Faction faction, EntityID origin, EntityID target, sf::Vector2f from, sf::Vector2f to) {
+        auto& hyperlanes = entityManager.getHyperlanes();
+        if (hyperlanes.isEnabled()) {
+            return hyperlanes.getRoute(faction, origin, target);
+        }
+        return entityManager.getNavigation().getRoute(origin, target, from, to);
+    }
+
+    // Create a drone flying from a position to a target structure along a known route, its arrival is queued
+    EntityID launchDroneOnRoute(GameEntityManager& entityManager, Components::Faction faction, EntityID origin, EntityID target, sf::Vector2f from, sf::Vector2f to, double time,
+                                double waveTime, std::shared_ptr<const Navigation::Route> route, std::string name = "") {
+        EntityID droneID = createDrone(entityManager, name, faction);
+        Entity& droneEntity = entityManager.getEntity(droneID);
+
+        if (auto* order = droneEntity.getComponent<Components::AttackOrderComponent>()) {
+            *order = Components::AttackOrderComponent{origin, target, waveTime};
+        } else {
+            entityManager.addComponent(droneID, Components::AttackOrderComponent{origin, target, waveTime});
+        }
+
+        // The whole flight, around the structures in the way, is known at launch, schedule the arrival
+        auto* droneMove = droneEntity.getComponent<Components::MoveComponent>();
+        droneMove->launch(from, to, time, std::move(route));
+        entityManager.addFlight(droneID);
+
+        auto* droneTransform = droneEntity.getComponent<Components::TransformComponent>();
+        droneTransform->transform.setPosition(from);
+        droneTransform->transform.setRotation(droneMove->heading);
+        return droneID;
+    }
+
+    // Create a drone flying from a position to a target structure, its arrival is queued
+    EntityID launchDrone(GameEntityManager& entityManager, Components::Faction faction, EntityID origin, EntityID target, sf::Vector2f from, sf::Vector2f to, double time,
+                         double waveTime, std::string name = "") {
+        return launchDroneOnRoute(entityManager, faction, origin, target, from, to, time, waveTime, findDroneRoute(entityManager, faction, origin, target, from, to), name);
+    }
 }
 
 
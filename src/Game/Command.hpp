@@ -0,0 +1,79 @@
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+
+namespace Game {
+
+    // A player order. Input queues it, the simulation applies it at the start of the next tick,
+    // so the seed and the list of commands are enough to play a match again.
+    struct Command {
+        enum class Type { ATTACK, TRANSFER, CANCEL_TRANSFER };
+
+        Type type = Type::ATTACK;
+        EntityID source = 0;
+        EntityID target = 0;
+        Components::Faction faction = Components::Faction::NEUTRAL; // Faction giving the order
+        std::uint64_t tick = 0;                                     // Tick it was applied at, set by the simulation
+    };
+
+    // Applied commands in order, saved as one "tick type source target faction" line each
+    class CommandLog {
+    public:
+        void add(const Command& command) {
+            commands.push_back(command);
+        }
+
+        const std::vector<Command>& getCommands() const {
+            return commands;
+        }
+
+        // Forget the commands applied after the given tick, e.g. after a rewind
+        void truncate(std::uint64_t tick) {
+            commands.erase(std::remove_if(commands.begin(), commands.end(), [tick](const Command& command) {
+                return command.tick > tick;
+            }), commands.end());
+        }
+
+        bool save(const std::string& path) const {
+            std::ofstream file(path);
+            if (!file) {
+                return false;
+            }
+            for (auto& command : commands) {
+                file << command.tick << ' ' << static_cast<int>(command.type) << ' ' << command.source << ' '
+                     << command.target << ' ' << static_cast<int>(command.faction) << '\n';
+            }
+            return static_cast<bool>(file);
+        }
+
+        bool load(const std::string& path) {
+            std::ifstream file(path);
+            if (!file) {
+                return false;
+            }
+            commands.clear();
+            Command command;
+            int type = 0;
+            int faction = 0;
+            while (file >> command.tick >> type >> command.source >> command.target >> faction) {
+                command.type = static_cast<Command::Type>(type);
+                command.faction = static_cast<Components::Faction>(faction);
+                commands.push_back(command);
+            }
+            return true;
+        }
+
+    private:
+        std::vector<Command> commands;
+    };
+}
+
+#endif // COMMAND_HPP
@@ -0,0 +1,165 @@
+#ifndef DISTANCE_TABLE_HPP
+#define DISTANCE_TABLE_HPP
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Game/StructureIndex.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Distances and straight flight times between structures, computed once when the map is generated.
+    // Structures are looked up by ID in a dense slot array, the IDs of a generated map are consecutive.
+    // Up to DISTANCE_MATRIX_MAX_STRUCTURES the table is the full matrix, each row padded to whole cache lines.
+    // Bigger maps keep the DISTANCE_NEIGHBOURS closest structures of each one, closest first, and compute
+    // the pairs beyond them from the positions.
+    class DistanceTable {
+    public:
+        struct Entry {
+            float distance;
+            float travelTime;   // Drone flight time, straight and at drone speed
+        };
+
+        void build(const std::vector<EntityID>& ids, const std::vector<sf::Vector2f>& positions) {
+            clear();
+            if (ids.empty()) {
+                return;
+            }
+            auto [first, last] = std::minmax_element(ids.begin(), ids.end());
+            firstID = *first;
+            slots.assign(*last - *first + 1, NONE);
+            for (size_t node = 0; node < ids.size(); ++node) {
+                slots[ids[node] - firstID] = static_cast<std::uint32_t>(node);
+            }
+            nodePositions = positions;
+
+            size_t count = ids.size();
+            if (count <= Config::DISTANCE_MATRIX_MAX_STRUCTURES) {
+                lineStride = (count + ENTRIES_PER_LINE - 1) / ENTRIES_PER_LINE;
+                lines.resize(count * lineStride);
+                for (size_t from = 0; from < count; ++from) {
+                    for (size_t to = 0; to < count; ++to) {
+                        getCell(from, to) = getEntry(from, to);
+                    }
+                }
+                return;
+            }
+
+            // The nearest neighbours of every structure, through a k-d tree over them
+            StructureIndex index;
+            for (size_t node = 0; node < count; ++node) {
+                index.addStructure(node, positions[node], Components::Faction::NEUTRAL);
+            }
+            neighbourCount = std::min<size_t>(Config::DISTANCE_NEIGHBOURS, count - 1);
+            neighbours.resize(count * neighbourCount);
+            std::vector<StructureIndex::Neighbour> nearest;
+            for (size_t from = 0; from < count; ++from) {
+                index.nearest(positions[from], neighbourCount, std::numeric_limits<float>::infinity(),
+                              [from](EntityID node, Components::Faction) { return node != from; }, nearest);
+                for (size_t i = 0; i < nearest.size(); ++i) {
+                    auto to = static_cast<std::uint32_t>(nearest[i].second);
+                    neighbours[from * neighbourCount + i] = Neighbour{to, getEntry(from, to)};
+                }
+            }
+        }
+
+        void clear() {
+            slots.clear();
+            nodePositions.clear();
+            lines.clear();
+            lineStride = 0;
+            neighbours.clear();
+            neighbourCount = 0;
+        }
+
+        size_t size() const {
+            return nodePositions.size();
+        }
+
+        bool isFullMatrix() const {
+            return !lines.empty();
+        }
+
+        // Distance and flight time between two structures, infinite when either is not in the table
+        Entry get(EntityID from, EntityID to) const {
+            std::uint32_t first = getSlot(from);
+            std::uint32_t second = getSlot(to);
+            if (first == NONE || second == NONE) {
+                return Entry{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+            }
+            if (isFullMatrix()) {
+                return getCell(first, second);
+            }
+            const Neighbour* row = &neighbours[static_cast<size_t>(first) * neighbourCount];
+            for (size_t i = 0; i < neighbourCount; ++i) {
+                if (row[i].node == second) {
+                    return row[i].entry;
+                }
+            }
+            return getEntry(first, second);
+        }
+
+        float getDistance(EntityID from, EntityID to) const {
+            return get(from, to).distance;
+        }
+
+        float getTravelTime(EntityID from, EntityID to) const {
+            return get(from, to).travelTime;
+        }
+
+        // Bytes held by the table, to weigh the full matrix against the neighbour lists
+        size_t getMemoryUsage() const {
+            return slots.capacity() * sizeof(std::uint32_t)
+                 + nodePositions.capacity() * sizeof(sf::Vector2f)
+                 + lines.capacity() * sizeof(Line)
+                 + neighbours.capacity() * sizeof(Neighbour);
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+        static constexpr size_t ENTRIES_PER_LINE = 8;
+
+        struct alignas(64) Line {
+            Entry entries[ENTRIES_PER_LINE];
+        };
+
+        struct Neighbour {
+            std::uint32_t node;
+            Entry entry;
+        };
+
+        EntityID firstID = 0;
+        std::vector<std::uint32_t> slots;           // Node of every ID from firstID on, NONE for other entities
+        std::vector<sf::Vector2f> nodePositions;
+        std::vector<Line> lines;                    // Full matrix, lineStride lines per row
+        size_t lineStride = 0;
+        std::vector<Neighbour> neighbours;          // Or neighbourCount nearest per node, closest first
+        size_t neighbourCount = 0;
+
+        std::uint32_t getSlot(EntityID id) const {
+            return id >= firstID && id - firstID < slots.size() ? slots[id - firstID] : NONE;
+        }
+
+        Entry& getCell(size_t from, size_t to) {
+            return lines[from * lineStride + to / ENTRIES_PER_LINE].entries[to % ENTRIES_PER_LINE];
+        }
+        const Entry& getCell(size_t from, size_t to) const {
+            return lines[from * lineStride + to / ENTRIES_PER_LINE].entries[to % ENTRIES_PER_LINE];
+        }
+
+        Entry getEntry(size_t from, size_t to) const {
+            sf::Vector2f delta = nodePositions[to] - nodePositions[from];
+            float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            return Entry{distance, Components::MoveComponent::getFlightTime(distance, Config::DRONE_SPEED)};
+        }
+    };
+}
+
+#endif // DISTANCE_TABLE_HPP
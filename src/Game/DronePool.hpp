@@ -0,0 +1,89 @@
+#ifndef DRONE_POOL_HPP
+#define DRONE_POOL_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "Core/EntityManager.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Drone entities that landed or were destroyed, kept with their components, shapes and labels so the next
+    // launch only sets their values again. Drones live a few seconds, once the pool has filled up a steady fight
+    // allocates no entities or components. Drones beyond the high-water mark are destroyed as before.
+    class DronePool {
+    public:
+        struct Statistics {
+            std::uint64_t requests = 0;     // Drones created
+            std::uint64_t hits = 0;         // Of those, taken from the pool
+            std::uint64_t released = 0;     // Drones kept on removal
+            std::uint64_t dropped = 0;      // Drones destroyed because the pool was full
+
+            float getHitRate() const {
+                return requests > 0 ? static_cast<float>(hits) / requests : 0.f;
+            }
+        };
+
+        explicit DronePool(size_t capacity = Config::DRONE_POOL_CAPACITY) {
+            setCapacity(capacity);
+        }
+
+        // High-water mark, pooled drones above it are destroyed
+        void setCapacity(size_t capacity) {
+            this->capacity = capacity;
+            if (entities.size() > capacity) {
+                entities.resize(capacity);
+            }
+            entities.reserve(capacity);
+        }
+
+        size_t getCapacity() const {
+            return capacity;
+        }
+
+        size_t size() const {
+            return entities.size();
+        }
+
+        // A drone entity to reuse, empty when the pool is
+        EntityManager::DetachedEntity acquire() {
+            statistics.requests++;
+            if (entities.empty()) {
+                return {};
+            }
+            statistics.hits++;
+            EntityManager::DetachedEntity entity = std::move(entities.back());
+            entities.pop_back();
+            return entity;
+        }
+
+        void release(EntityManager::DetachedEntity entity) {
+            if (entity.empty()) {
+                return;
+            }
+            if (entities.size() >= capacity) {
+                statistics.dropped++;
+                return;
+            }
+            statistics.released++;
+            entities.push_back(std::move(entity));
+        }
+
+        const Statistics& getStatistics() const {
+            return statistics;
+        }
+
+        void clear() {
+            entities.clear();
+            statistics = Statistics();
+        }
+
+    private:
+        size_t capacity = 0;
+        std::vector<EntityManager::DetachedEntity> entities;
+        Statistics statistics;
+    };
+}
+
+#endif // DRONE_POOL_HPP
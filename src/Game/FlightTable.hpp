@@ -0,0 +1,340 @@
+#ifndef FLIGHT_TABLE_HPP
+#define FLIGHT_TABLE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Utils/FlightKernel.hpp"
+#include "Utils/FlockingKernel.hpp"
+#include "Utils/SpatialHash.hpp"
+#include "Utils/WorkerPool.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Structure-of-arrays copy of every flight in progress.
+    // Rows are added at launch and swap-removed when the drone is removed,
+    // so the arrays stay dense and can be fed to the vectorised flight kernel.
+    // A row holds the current leg of a flight, rows whose leg ended are turned to the next corner after each pass.
+    // Leg times are kept as floats relative to an epoch that follows the clock, so the kernel stays in float
+    // however long the match runs.
+    class FlightTable {
+    public:
+        // The component must outlive the row, drones are removed from the table before their entity is
+        void add(EntityID droneID, Components::MoveComponent& move, std::uint32_t fleet = 0, std::uint32_t faction = 0, std::uint16_t visionCell = 0, std::uint16_t regionCell = 0) {
+            slots[droneID] = drones.size();
+            drones.push_back(droneID);
+            moves.push_back(&move);
+            factions.push_back(faction);
+            visionCells.push_back(visionCell);
+            regionCells.push_back(regionCell);
+            fleets.push_back(fleet);
+            offsetX.push_back(0.f);
+            offsetY.push_back(0.f);
+            velocityX.push_back(0.f);
+            velocityY.push_back(0.f);
+            steerX.push_back(0.f);
+            steerY.push_back(0.f);
+            displayX.push_back(move.launchPosition.x);
+            displayY.push_back(move.launchPosition.y);
+            launchX.push_back(0.f);
+            launchY.push_back(0.f);
+            dirX.push_back(0.f);
+            dirY.push_back(0.f);
+            speed.push_back(move.speed);
+            launchTime.push_back(0.f);
+            arrivalTime.push_back(0.f);
+            targetX.push_back(0.f);
+            targetY.push_back(0.f);
+            x.push_back(move.launchPosition.x);
+            y.push_back(move.launchPosition.y);
+            flags.push_back(0);
+            onScreen.push_back(0);
+            setLeg(drones.size() - 1);
+        }
+
+        void remove(EntityID droneID) {
+            auto it = slots.find(droneID);
+            if (it == slots.end()) {
+                return;
+            }
+            size_t slot = it->second;
+            size_t last = drones.size() - 1;
+            slots.erase(it);
+
+            if (slot != last) {
+                drones[slot] = drones[last];
+                moves[slot] = moves[last];
+                factions[slot] = factions[last];
+                visionCells[slot] = visionCells[last];
+                regionCells[slot] = regionCells[last];
+                fleets[slot] = fleets[last];
+                offsetX[slot] = offsetX[last];
+                offsetY[slot] = offsetY[last];
+                velocityX[slot] = velocityX[last];
+                velocityY[slot] = velocityY[last];
+                displayX[slot] = displayX[last];
+                displayY[slot] = displayY[last];
+                launchX[slot] = launchX[last];
+                launchY[slot] = launchY[last];
+                dirX[slot] = dirX[last];
+                dirY[slot] = dirY[last];
+                speed[slot] = speed[last];
+                launchTime[slot] = launchTime[last];
+                arrivalTime[slot] = arrivalTime[last];
+                targetX[slot] = targetX[last];
+                targetY[slot] = targetY[last];
+                x[slot] = x[last];
+                y[slot] = y[last];
+                flags[slot] = flags[last];
+                onScreen[slot] = onScreen[last];
+                slots[drones[slot]] = slot;
+            }
+
+            drones.pop_back();
+            moves.pop_back();
+            factions.pop_back();
+            visionCells.pop_back();
+            regionCells.pop_back();
+            fleets.pop_back();
+            offsetX.pop_back();
+            offsetY.pop_back();
+            velocityX.pop_back();
+            velocityY.pop_back();
+            steerX.pop_back();
+            steerY.pop_back();
+            displayX.pop_back();
+            displayY.pop_back();
+            launchX.pop_back();
+            launchY.pop_back();
+            dirX.pop_back();
+            dirY.pop_back();
+            speed.pop_back();
+            launchTime.pop_back();
+            arrivalTime.pop_back();
+            targetX.pop_back();
+            targetY.pop_back();
+            x.pop_back();
+            y.pop_back();
+            flags.pop_back();
+            onScreen.pop_back();
+        }
+
+        // Evaluate every flight at the given time, flags visibility against the area.
+        // With workers the rows are split into chunks, every row is computed alike so the results do not change.
+        void evaluate(double time, const sf::FloatRect& area, Utils::WorkerPool* workers = nullptr) {
+            double timeEpoch = std::floor(time / Config::FLIGHT_EPOCH_SEC) * Config::FLIGHT_EPOCH_SEC;
+            if (timeEpoch != epoch) {
+                setEpoch(timeEpoch);
+            }
+            float relative = getRelativeTime(time);
+            Utils::Kernels::ViewRect view{area.left, area.top, area.left + area.width, area.top + area.height};
+            forEachChunk(workers, [this, time, relative, &view](size_t begin, size_t end) {
+                Utils::Kernels::FlightBatch batch = getBatch(begin, end);
+                Utils::Kernels::evaluateFlights(batch, relative, view);
+
+                // Legs that ended turn to the next corner, only those rows are evaluated again
+                for (size_t slot = begin; slot < end; ++slot) {
+                    if ((flags[slot] & Utils::Kernels::FLIGHT_ARRIVED) && moves[slot]->advanceLeg(time)) {
+                        setLeg(slot);
+                        batch.count = slot - begin + 1;
+                        Utils::Kernels::evaluateFlightsScalar(batch, slot - begin, relative, view);
+                    }
+                }
+            });
+        }
+
+        // Positions at two times of the simulation, the previous and the current tick, for swept collision tests
+        void sweep(double from, double to, Utils::WorkerPool* workers = nullptr) {
+            const sf::FloatRect everywhere(-1e9f, -1e9f, 2e9f, 2e9f);
+            evaluate(from, everywhere, workers);
+            sweepStartX.assign(x.begin(), x.end());
+            sweepStartY.assign(y.begin(), y.end());
+            evaluate(to, everywhere, workers);
+        }
+
+        // Results of the last sweep(), the end positions are the ones of getPosition()
+        sf::Vector2f getSweepStart(size_t slot) const { return {sweepStartX[slot], sweepStartY[slot]}; }
+        const float* getPositionsX() const { return x.data(); }
+        const float* getPositionsY() const { return y.data(); }
+        std::uint32_t getFaction(size_t slot) const { return factions[slot]; }
+
+        // Fog of war cell the drone currently reveals from
+        std::uint16_t getVisionCell(size_t slot) const { return visionCells[slot]; }
+        void setVisionCell(size_t slot, std::uint16_t cell) { visionCells[slot] = cell; }
+
+        // Region tree cell the drone is counted in
+        std::uint16_t getRegionCell(size_t slot) const { return regionCells[slot]; }
+        void setRegionCell(size_t slot, std::uint16_t cell) { regionCells[slot] = cell; }
+
+        // Separation and cohesion within fleets on top of the positions of the last evaluate().
+        // Offsets are cosmetic, the flights and their arrivals do not change.
+        void flock(double time, Utils::WorkerPool* workers = nullptr) {
+            float dt = std::min(static_cast<float>(time - lastFlockTime), Config::FLOCK_MAX_STEP_SEC);
+            bool advance = lastFlockTime >= 0.0 && dt > 0.f;
+            lastFlockTime = time;
+            size_t count = drones.size();
+
+            if (advance && count > 0) {
+                for (size_t i = 0; i < count; ++i) {
+                    displayX[i] = x[i] + offsetX[i];
+                    displayY[i] = y[i] + offsetY[i];
+                }
+                static const Utils::Kernels::FlockParameters parameters{
+                    Config::FLOCK_RADIUS, Config::FLOCK_SEPARATION, Config::FLOCK_COHESION,
+                    Config::FLOCK_SPRING, Config::FLOCK_DAMPING, Config::FLOCK_MAX_OFFSET
+                };
+                flockHash.build(displayX.data(), displayY.data(), fleets.data(), count, Config::FLOCK_RADIUS);
+                Utils::Kernels::FlockBatch batch = getFlockBatch();
+                // Steering reads the neighbours' positions, every chunk is steered before any is moved
+                forEachChunk(workers, [&](size_t begin, size_t end) {
+                    Utils::Kernels::steerFlock(batch, flockHash, parameters, begin, end);
+                });
+                forEachChunk(workers, [&](size_t begin, size_t end) {
+                    Utils::Kernels::integrateFlock(batch, parameters, dt, begin, end);
+                });
+            }
+            for (size_t i = 0; i < count; ++i) {
+                displayX[i] = x[i] + offsetX[i];
+                displayY[i] = y[i] + offsetY[i];
+            }
+        }
+
+        Utils::Kernels::FlockBatch getFlockBatch() {
+            return Utils::Kernels::FlockBatch{
+                displayX.data(), displayY.data(),
+                fleets.data(),
+                offsetX.data(), offsetY.data(),
+                velocityX.data(), velocityY.data(),
+                steerX.data(), steerY.data(),
+                drones.size()
+            };
+        }
+
+        Utils::Kernels::FlightBatch getBatch() {
+            return getBatch(0, drones.size());
+        }
+
+        // Kernel time of a simulation time, the batches' leg times are relative to the same epoch
+        float getRelativeTime(double time) const {
+            return static_cast<float>(time - epoch);
+        }
+
+        // Rows begin to end, indexed from 0
+        Utils::Kernels::FlightBatch getBatch(size_t begin, size_t end) {
+            return Utils::Kernels::FlightBatch{
+                launchX.data() + begin, launchY.data() + begin,
+                dirX.data() + begin, dirY.data() + begin,
+                speed.data() + begin,
+                launchTime.data() + begin, arrivalTime.data() + begin,
+                targetX.data() + begin, targetY.data() + begin,
+                x.data() + begin, y.data() + begin,
+                flags.data() + begin,
+                end - begin
+            };
+        }
+
+        size_t size() const { return drones.size(); }
+        bool contains(EntityID droneID) const { return slots.count(droneID) > 0; }
+        // Row of a drone, size() when it is not in flight
+        size_t getSlot(EntityID droneID) const {
+            auto it = slots.find(droneID);
+            return it != slots.end() ? it->second : drones.size();
+        }
+        EntityID getDrone(size_t slot) const { return drones[slot]; }
+
+        // Results of the last evaluate()
+        sf::Vector2f getPosition(size_t slot) const { return {x[slot], y[slot]}; }
+        // Results of the last flock(), where the drone is drawn
+        sf::Vector2f getDisplayPosition(size_t slot) const { return {displayX[slot], displayY[slot]}; }
+        bool isVisible(size_t slot) const { return flags[slot] & Utils::Kernels::FLIGHT_VISIBLE; }
+        bool hasArrived(size_t slot) const { return flags[slot] & Utils::Kernels::FLIGHT_ARRIVED; }
+
+        // Whether the drone was drawn last frame, so only visibility changes touch the entity
+        bool wasOnScreen(size_t slot) const { return onScreen[slot]; }
+        void setOnScreen(size_t slot, bool visible) { onScreen[slot] = visible; }
+
+        void clear() {
+            *this = FlightTable();
+        }
+
+    private:
+        std::unordered_map<EntityID, size_t> slots;
+        std::vector<EntityID> drones;
+        std::vector<Components::MoveComponent*> moves;
+        std::vector<std::uint32_t> factions;
+        std::vector<std::uint16_t> visionCells;
+        std::vector<std::uint16_t> regionCells;
+        std::vector<float> sweepStartX, sweepStartY;
+
+        // Flocking state, offsets from the flight path
+        std::vector<std::uint32_t> fleets;
+        std::vector<float> offsetX, offsetY;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> steerX, steerY;
+        std::vector<float> displayX, displayY;
+        Utils::SpatialHash flockHash;
+        double lastFlockTime = -1.0;
+        double epoch = 0.0;             // Simulation time the rows' leg times count from
+
+        static constexpr size_t MIN_CHUNK_ROWS = 1024;  // Smaller chunks cost more to hand out than to compute
+
+        // Call task(begin, end) over row ranges covering the table, on the workers when there are enough rows
+        template<typename Task>
+        void forEachChunk(Utils::WorkerPool* workers, Task task) {
+            size_t count = drones.size();
+            size_t chunks = 1;
+            if (workers && workers->getThreadCount() > 1) {
+                chunks = std::min<size_t>(workers->getThreadCount() * 4, (count + MIN_CHUNK_ROWS - 1) / MIN_CHUNK_ROWS);
+            }
+            if (chunks <= 1) {
+                task(0, count);
+                return;
+            }
+            size_t step = (count + chunks - 1) / chunks;
+            workers->run(chunks, [&](size_t chunk) {
+                size_t begin = std::min(count, chunk * step);
+                task(begin, std::min(count, begin + step));
+            });
+        }
+
+        void setLeg(size_t slot) {
+            const auto& move = *moves[slot];
+            launchX[slot] = move.legStart.x;
+            launchY[slot] = move.legStart.y;
+            dirX[slot] = move.direction.x;
+            dirY[slot] = move.direction.y;
+            launchTime[slot] = getRelativeTime(move.legStartTime);
+            arrivalTime[slot] = getRelativeTime(move.legEndTime);
+            targetX[slot] = move.legEnd.x;
+            targetY[slot] = move.legEnd.y;
+        }
+
+        // The epoch only depends on the time evaluated, never on which times were evaluated before, so rendering
+        // at any frame rate leaves the simulation's positions alone. Leg times are taken again from the flights.
+        void setEpoch(double time) {
+            epoch = time;
+            for (size_t slot = 0; slot < drones.size(); ++slot) {
+                launchTime[slot] = getRelativeTime(moves[slot]->legStartTime);
+                arrivalTime[slot] = getRelativeTime(moves[slot]->legEndTime);
+            }
+        }
+
+        std::vector<float> launchX, launchY;
+        std::vector<float> dirX, dirY;
+        std::vector<float> speed;
+        std::vector<float> launchTime, arrivalTime;
+        std::vector<float> targetX, targetY;
+
+        std::vector<float> x, y;
+        std::vector<unsigned char> flags;
+        std::vector<unsigned char> onScreen;
+    };
+}
+
+#endif // FLIGHT_TABLE_HPP
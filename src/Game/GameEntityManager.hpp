@@ -3,13 +3,44 @@
 
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Core/EntityManager.hpp"
+#include "Core/TimerWheel.hpp"
 #include "Components/FactoryComponent.hpp"
 #include "Components/DroneComponent.hpp"
 #include "Components/ShieldComponent.hpp"
 #include "Components/GameStateComponent.hpp"
 #include "Components/AIComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+#include "Components/HoverComponent.hpp"
+#include "Components/SelectableComponent.hpp"
+
+#include "Game/ArrivalQueue.hpp"
+#include "Game/FlightTable.hpp"
+#include "Game/Navigation.hpp"
+#include "Game/Visibility.hpp"
+#include "Game/PowerGrid.hpp"
+#include "Game/Hyperlanes.hpp"
+#include "Game/TileGrid.hpp"
+#include "Game/InterceptionBuffers.hpp"
+#include "Game/DronePool.hpp"
+#include "Game/PickingGrid.hpp"
+#include "Game/StructureIndex.hpp"
+#include "Game/DistanceTable.hpp"
+#include "Game/RegionTree.hpp"
+
+#include "Utils/Random.hpp"
+#include "Utils/Hash.hpp"
+#include "Utils/WorkerPool.hpp"
+#include "Config.hpp"
 
 namespace Game {
 
@@ -21,10 +52,164 @@ namespace Game {
         std::vector<EntityID> factoryEntities;
         std::vector<EntityID> shieldEntities;
         std::vector<EntityID> droneEntities;
+        std::vector<EntityID> garissonEntities;
+
+        // Drones in flight ordered by arrival time
+        ArrivalQueue arrivals;
+        // Drones in flight as structure-of-arrays for batched position evaluation
+        FlightTable flights;
+        // One-shot and periodic callbacks (production, AI turns, ...)
+        TimerWheel timers;
+        // Structures as obstacles and the flow fields around them
+        Navigation navigation;
+        // What each faction sees, derived from the structures and flights above
+        Visibility visibility;
+        // Which structures share power, derived from ownership
+        PowerGrid powerGrid;
+        // Lanes drones are bound to in hyperlane matches, empty otherwise
+        Hyperlanes hyperlanes;
+        // Structures by position and owner, for the AI's nearest target queries
+        StructureIndex structures;
+        // Distances and flight times between structures, filled by the map generator
+        DistanceTable distances;
+        // Strength of every faction by map region, for questions like "enemy drones within R"
+        RegionTree regions;
+        // Where the mouse can hover or select, by screen bounds
+        PickingGrid picking;
+        // Removed drone entities waiting to be launched again
+        DronePool dronePool;
+        // Drones in flight by the map tile they are above, the unit of work handed to the worker threads
+        TileGrid tiles;
+        InterceptionBuffers interception;
+        Utils::WorkerPool workers;
+        // Every random decision of the match, seeded so a match can be replayed
+        Utils::Random random;
+
+        // Order-independent hash of the drones in flight, summed at launch and subtracted at removal
+        std::uint64_t droneHash = 0;
+
+        // Drones created and removed since the last drain, kept only while a rewind buffer listens
+        bool droneJournalEnabled = false;
+        std::vector<EntityID> spawnedDrones;
+        std::vector<EntityID> removedDrones;
 
         // Game special entities
-        EntityID gameStateEntityID;
-        EntityID AIEntityID;
+        EntityID gameStateEntityID = 0;
+        std::vector<EntityID> aiEntities;   // One AI per computer player, in creation order
+
+        // Drop an entity from every list but the drone list, callers compact that one
+        void eraseEntity(EntityID id, Entity& entity) {
+            if (entity.hasComponent<Components::FactoryComponent>()) {
+                factoryEntities.erase(std::remove(factoryEntities.begin(), factoryEntities.end(), id), factoryEntities.end());
+            }
+            if (entity.hasComponent<Components::ShieldComponent>()) {
+                shieldEntities.erase(std::remove(shieldEntities.begin(), shieldEntities.end(), id), shieldEntities.end());
+            }
+            if (entity.hasComponent<Components::DroneComponent>()) {
+                size_t slot = flights.getSlot(id);
+                if (slot < flights.size()) {
+                    droneHash -= hashDrone(entity);
+                    visibility.removeDrone(static_cast<Components::Faction>(flights.getFaction(slot)), flights.getVisionCell(slot));
+                    regions.removeDrone(static_cast<Components::Faction>(flights.getFaction(slot)), flights.getRegionCell(slot));
+                }
+                flights.remove(id);
+                if (droneJournalEnabled) {
+                    removedDrones.push_back(id);
+                }
+            }
+            if (entity.hasComponent<Components::GarissonComponent>()) {
+                garissonEntities.erase(std::remove(garissonEntities.begin(), garissonEntities.end(), id), garissonEntities.end());
+                navigation.removeObstacle(id);
+                visibility.removeStructure(id);
+                powerGrid.removeStructure(id);
+                structures.removeStructure(id);
+                regions.removeStructure(id);
+            }
+            if (entity.hasComponent<Components::HoverComponent>() || entity.hasComponent<Components::SelectableComponent>()) {
+                picking.remove(id);
+            }
+            if (entity.hasComponent<Components::GameStateComponent>()) {
+                gameStateEntityID = 0;
+            }
+            if (entity.hasComponent<Components::AIComponent>()) {
+                aiEntities.erase(std::remove(aiEntities.begin(), aiEntities.end(), id), aiEntities.end());
+            }
+
+            if (entity.hasComponent<Components::DroneComponent>() && !entity.hasComponent<Components::GarissonComponent>()) {
+                // Let go of the route now rather than when the drone flies again
+                if (auto* move = entity.getComponent<Components::MoveComponent>()) {
+                    move->route.reset();
+                }
+                dronePool.release(coreManager.detachEntity(id));
+                return;
+            }
+            coreManager.removeEntity(id);
+        }
+
+        // Hand a structure's current values to the region tree
+        void syncRegion(EntityID id) {
+            Entity& entity = getEntity(id);
+            auto* transform = entity.getComponent<Components::TransformComponent>();
+            if (!transform) {
+                return;
+            }
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            auto* garisson = entity.getComponent<Components::GarissonComponent>();
+            auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>();
+            Components::ShieldComponent noShield(0.f, 0.f, 0.f);
+            auto* shield = entity.getComponent<Components::ShieldComponent>();
+            if (!shield) {
+                shield = &noShield;
+            }
+            regions.setStructure(id, transform->getPosition(), faction ? faction->faction : Components::Faction::NEUTRAL,
+                                 garisson ? garisson->getDroneCount() : 0, powerPlant ? powerPlant->capacity : 0,
+                                 shield->baseShield, shield->baseTime, shield->maxShield, shield->regenRate);
+        }
+
+        // A flight is fixed at launch, so its parameters stand for the drone's position at any time.
+        // The ID is left out, drones restored by a rewind get new IDs but are the same drones.
+        static std::uint64_t hashDrone(Entity& entity) {
+            std::uint64_t hash = 0;
+            if (auto* faction = entity.getComponent<Components::FactionComponent>()) {
+                hash = Utils::Hash::combine(hash, static_cast<std::uint64_t>(faction->faction));
+            }
+            if (auto* order = entity.getComponent<Components::AttackOrderComponent>()) {
+                hash = Utils::Hash::combine(hash, order->origin);
+                hash = Utils::Hash::combine(hash, order->target);
+            }
+            if (auto* move = entity.getComponent<Components::MoveComponent>()) {
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofPosition(move->launchPosition.x));
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofPosition(move->launchPosition.y));
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofPosition(move->targetPosition.x));
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofPosition(move->targetPosition.y));
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofDouble(move->launchTime));
+                hash = Utils::Hash::combine(hash, Utils::Hash::ofDouble(move->arrivalTime));
+            }
+            return hash;
+        }
+
+        // Add (sign = 1) or take away (sign = -1) what a unit contributes to the per-faction aggregates
+        void applyUnit(Entity& entity, int sign) {
+            auto* gameState = getGameState();
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            if (!gameState || !faction) {
+                return;
+            }
+
+            if (auto* garisson = entity.getComponent<Components::GarissonComponent>()) {
+                gameState->structureCount[faction->faction] += sign;
+                gameState->garrisonedDrones[faction->faction] += sign * static_cast<int>(garisson->getDroneCount());
+                if (auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>()) {
+                    gameState->playerEnergy[faction->faction] += sign * static_cast<int>(powerPlant->capacity);
+                }
+            } else if (entity.hasComponent<Components::DroneComponent>()) {
+                gameState->inFlightDrones[faction->faction] += sign;
+            }
+
+            if (sign < 0) {
+                gameState->updateGameOver();
+            }
+        }
 
     public:
         // Create a new entity
@@ -32,6 +217,18 @@ namespace Game {
             return coreManager.createEntity();
         }
 
+        // Bring a removed drone back under a new ID, listed as a drone but not yet counted, 0 when none is pooled.
+        // Its components still hold the values of its last flight, the caller sets them and then calls registerUnit().
+        EntityID reuseDrone() {
+            auto entity = dronePool.acquire();
+            if (entity.empty()) {
+                return 0;
+            }
+            EntityID id = coreManager.attachEntity(std::move(entity));
+            droneEntities.push_back(id);
+            return id;
+        }
+
         // Default constructor
         GameEntityManager() = default;
 
@@ -47,6 +244,11 @@ namespace Game {
             return nullptr;
         }
 
+        // Check if an entity exists
+        bool hasEntity(EntityID id) const {
+            return coreManager.hasEntity(id);
+        }
+
         // Access a specific entity
         Entity& getEntity(EntityID id) {
             return coreManager.getEntity(id);
@@ -81,23 +283,51 @@ namespace Game {
             if (coreManager.hasEntity(id)) {
                 auto& entity = coreManager.getEntity(id);
 
-                if (entity.hasComponent<Components::FactoryComponent>()) {
-                    factoryEntities.erase(std::remove(factoryEntities.begin(), factoryEntities.end(), id), factoryEntities.end());
-                }
-                if (entity.hasComponent<Components::ShieldComponent>()) {
-                    shieldEntities.erase(std::remove(shieldEntities.begin(), shieldEntities.end(), id), shieldEntities.end());
-                }
+                applyUnit(entity, -1);
+
                 if (entity.hasComponent<Components::DroneComponent>()) {
                     droneEntities.erase(std::remove(droneEntities.begin(), droneEntities.end(), id), droneEntities.end());
                 }
-                if (entity.hasComponent<Components::GameStateComponent>()) {
-                    gameStateEntityID = 0;
+                eraseEntity(id, entity);
+            }
+        }
+
+        // Remove a batch of entities, e.g. the drones that landed this tick.
+        // In-flight counts are applied once per faction and the drone list is compacted in a single pass.
+        void removeEntities(const std::vector<EntityID>& ids) {
+            Components::PerFaction<int> landed;
+            std::unordered_set<EntityID> removedDrones;
+
+            for (EntityID id : ids) {
+                if (!coreManager.hasEntity(id)) {
+                    continue;
                 }
-                if (entity.hasComponent<Components::AIComponent>()) {
-                    AIEntityID = 0;
+                auto& entity = coreManager.getEntity(id);
+                auto* faction = entity.getComponent<Components::FactionComponent>();
+
+                if (entity.hasComponent<Components::DroneComponent>() && !entity.hasComponent<Components::GarissonComponent>()) {
+                    if (faction) {
+                        landed[faction->faction]++;
+                    }
+                    removedDrones.insert(id);
+                } else {
+                    applyUnit(entity, -1);
                 }
+                eraseEntity(id, entity);
+            }
 
-                coreManager.removeEntity(id);
+            if (!removedDrones.empty()) {
+                droneEntities.erase(std::remove_if(droneEntities.begin(), droneEntities.end(), [&removedDrones](EntityID id) {
+                    return removedDrones.count(id) > 0;
+                }), droneEntities.end());
+            }
+
+            auto* gameState = getGameState();
+            if (gameState && !removedDrones.empty()) {
+                for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                    gameState->inFlightDrones.values[faction] -= landed.values[faction];
+                }
+                gameState->updateGameOver();
             }
         }
 
@@ -115,11 +345,14 @@ namespace Game {
             if constexpr (std::is_same<T, Components::DroneComponent>::value) {
                 droneEntities.push_back(id);
             }
+            if constexpr (std::is_same<T, Components::GarissonComponent>::value) {
+                garissonEntities.push_back(id);
+            }
             if constexpr (std::is_same<T, Components::GameStateComponent>::value) {
                 gameStateEntityID = id;
             }
             if constexpr (std::is_same<T, Components::AIComponent>::value) {
-                AIEntityID = id;
+                aiEntities.push_back(id);
             }
         }
 
@@ -137,14 +370,186 @@ namespace Game {
             if constexpr (std::is_same<T, Components::DroneComponent>::value) {
                 droneEntities.erase(std::remove(droneEntities.begin(), droneEntities.end(), id), droneEntities.end());
             }
+            if constexpr (std::is_same<T, Components::GarissonComponent>::value) {
+                garissonEntities.erase(std::remove(garissonEntities.begin(), garissonEntities.end(), id), garissonEntities.end());
+            }
             if constexpr (std::is_same<T, Components::GameStateComponent>::value) {
                 gameStateEntityID = 0;
             }
             if constexpr (std::is_same<T, Components::AIComponent>::value) {
-                AIEntityID = 0;
+                aiEntities.erase(std::remove(aiEntities.begin(), aiEntities.end(), id), aiEntities.end());
             }
         }
 
+        // Count a freshly built structure or drone in the per-faction aggregates, called once its components are in place
+        void registerUnit(EntityID id) {
+            Entity& entity = getEntity(id);
+            applyUnit(entity, 1);
+            if (droneJournalEnabled && entity.hasComponent<Components::DroneComponent>()) {
+                spawnedDrones.push_back(id);
+            }
+
+            // Structures block flights
+            auto* transform = entity.getComponent<Components::TransformComponent>();
+            if (transform && entity.hasComponent<Components::GarissonComponent>()) {
+                float radius = entity.hasComponent<Components::FactoryComponent>() ? Config::FACTORY_SIZE * 0.7071f : Config::POWER_PLANT_RADIUS;
+                navigation.addObstacle(id, transform->getPosition(), radius);
+                auto* faction = entity.getComponent<Components::FactionComponent>();
+                auto owner = faction ? faction->faction : Components::Faction::NEUTRAL;
+                auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>();
+                visibility.setStructure(id, transform->getPosition(), owner);
+                powerGrid.addStructure(id, transform->getPosition(), owner, powerPlant ? powerPlant->capacity : 0);
+                powerGrid.setDrones(id, entity.getComponent<Components::GarissonComponent>()->getDroneCount());
+                structures.addStructure(id, transform->getPosition(), owner);
+                syncRegion(id);
+            }
+
+            // Bounds as drawn, the shape is placed at the transform the way the render system does
+            auto* shape = entity.getComponent<Components::ShapeComponent>();
+            unsigned char flags = (entity.hasComponent<Components::HoverComponent>() ? PickingGrid::HOVERABLE : 0)
+                                | (entity.hasComponent<Components::SelectableComponent>() ? PickingGrid::SELECTABLE : 0);
+            if (transform && shape && shape->shape && flags != 0) {
+                shape->shape->setPosition(transform->getPosition());
+                shape->shape->setRotation(transform->getRotation());
+                shape->shape->setScale(transform->getScale());
+                picking.insert(id, shape->shape->getGlobalBounds(), flags);
+            }
+        }
+
+        // Recount the per-faction aggregates from scratch, after the world was restored
+        void rebuildAggregates() {
+            auto* gameState = getGameState();
+            if (!gameState) {
+                return;
+            }
+            for (auto* aggregate : {&gameState->playerEnergy, &gameState->structureCount, &gameState->garrisonedDrones, &gameState->inFlightDrones}) {
+                aggregate->fill(0);
+            }
+            for (auto& [id, entity] : coreManager.getAllEntities()) {
+                applyUnit(entity, 1);
+            }
+            for (EntityID id : garissonEntities) {
+                auto* faction = getComponent<Components::FactionComponent>(id);
+                auto* transform = getComponent<Components::TransformComponent>(id);
+                if (faction && transform) {
+                    visibility.setStructure(id, transform->getPosition(), faction->faction);
+                    powerGrid.setFaction(id, faction->faction);
+                    powerGrid.setDrones(id, getComponent<Components::GarissonComponent>(id)->getDroneCount());
+                    hyperlanes.setFaction(id, faction->faction);
+                    structures.setFaction(id, faction->faction);
+                    syncRegion(id);
+                }
+            }
+
+            // Drones were relaunched from where they took off, count them where they are now
+            flights.evaluate(getTime(), sf::FloatRect(-1e9f, -1e9f, 2e9f, 2e9f));
+            updateDroneRegions();
+        }
+
+        void setDroneJournal(bool enabled) {
+            droneJournalEnabled = enabled;
+            spawnedDrones.clear();
+            removedDrones.clear();
+        }
+
+        // Hand over the drones created and removed since the last call
+        void drainDroneJournal(std::vector<EntityID>& spawned, std::vector<EntityID>& removed) {
+            spawned.swap(spawnedDrones);
+            removed.swap(removedDrones);
+            spawnedDrones.clear();
+            removedDrones.clear();
+        }
+
+        // Put a launched drone on the arrival queue and the flight table
+        void addFlight(EntityID id) {
+            Entity& entity = getEntity(id);
+            auto* move = entity.getComponent<Components::MoveComponent>();
+            if (!move) {
+                return;
+            }
+            // Drones of one wave flock together, a wave streams out over many ticks
+            std::uint64_t fleet = Utils::Hash::ofDouble(move->launchTime);
+            if (auto* order = entity.getComponent<Components::AttackOrderComponent>()) {
+                fleet = Utils::Hash::combine(Utils::Hash::combine(Utils::Hash::ofDouble(order->waveTime), order->origin), order->target);
+            }
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            auto owner = faction ? faction->faction : Components::Faction::NEUTRAL;
+            auto visionCell = visibility.getCell(move->launchPosition);
+            auto regionCell = regions.getCell(move->launchPosition);
+            arrivals.push(id, move->arrivalTime);
+            flights.add(id, *move, static_cast<std::uint32_t>(fleet), static_cast<std::uint32_t>(owner), visionCell, regionCell);
+            tiles.place(id, move->launchPosition);
+            visibility.addDrone(owner, visionCell);
+            regions.addDrone(owner, regionCell);
+            droneHash += hashDrone(entity);
+        }
+
+        // Hand a structure, and the drones parked at it, over to another faction
+        void setOwner(EntityID id, Components::Faction owner) {
+            Entity& entity = getEntity(id);
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            if (!faction || faction->faction == owner) {
+                return;
+            }
+            applyUnit(entity, -1);
+            faction->faction = owner;
+            applyUnit(entity, 1);
+            if (auto* transform = entity.getComponent<Components::TransformComponent>()) {
+                visibility.setStructure(id, transform->getPosition(), owner);
+            }
+            powerGrid.setFaction(id, owner);
+            hyperlanes.setFaction(id, owner);
+            structures.setFaction(id, owner);
+            regions.setFaction(id, owner);
+        }
+
+        // Move the drones in flight that crossed into another region cell, reads the positions of the last flight table evaluation
+        void updateDroneRegions() {
+            for (size_t slot = 0; slot < flights.size(); ++slot) {
+                auto cell = regions.getCell(flights.getPosition(slot));
+                auto previous = flights.getRegionCell(slot);
+                if (cell != previous) {
+                    regions.moveDrone(static_cast<Components::Faction>(flights.getFaction(slot)), previous, cell);
+                    flights.setRegionCell(slot, cell);
+                }
+            }
+        }
+
+        // Set what is left of a structure's shield after a hit
+        void setShield(EntityID id, float shield, double time) {
+            auto* shieldComp = getComponent<Components::ShieldComponent>(id);
+            if (!shieldComp) {
+                return;
+            }
+            shieldComp->setShield(shield, time);
+            regions.setShield(id, shieldComp->baseShield, shieldComp->baseTime);
+        }
+
+        // Change the number of drones parked at a structure
+        void addGarrisonDrones(EntityID id, int delta) {
+            auto* garisson = getComponent<Components::GarissonComponent>(id);
+            if (!garisson) {
+                return;
+            }
+            setGarrisonDrones(id, static_cast<unsigned int>(static_cast<int>(garisson->getDroneCount()) + delta));
+        }
+
+        void setGarrisonDrones(EntityID id, unsigned int count) {
+            Entity& entity = getEntity(id);
+            auto* garisson = entity.getComponent<Components::GarissonComponent>();
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            auto* gameState = getGameState();
+            if (!garisson) {
+                return;
+            }
+            if (faction && gameState) {
+                gameState->garrisonedDrones[faction->faction] += static_cast<int>(count) - static_cast<int>(garisson->getDroneCount());
+            }
+            garisson->setDroneCount(count);
+            powerGrid.setDrones(id, count);
+            regions.setGarrison(id, count);
+        }
+
         // Get game-specific entity lists
         const std::vector<EntityID>& getFactories() const {
             return factoryEntities;
@@ -155,14 +560,92 @@ namespace Game {
         const std::vector<EntityID>& getDrones() const {
             return droneEntities;
         }
+        const std::vector<EntityID>& getGarissons() const {
+            return garissonEntities;
+        }
+        ArrivalQueue& getArrivals() {
+            return arrivals;
+        }
+        FlightTable& getFlights() {
+            return flights;
+        }
+        TimerWheel& getTimers() {
+            return timers;
+        }
+        Navigation& getNavigation() {
+            return navigation;
+        }
+        Visibility& getVisibility() {
+            return visibility;
+        }
+        PowerGrid& getPowerGrid() {
+            return powerGrid;
+        }
+        Hyperlanes& getHyperlanes() {
+            return hyperlanes;
+        }
+        StructureIndex& getStructureIndex() {
+            return structures;
+        }
+        DistanceTable& getDistances() {
+            return distances;
+        }
+        RegionTree& getRegions() {
+            return regions;
+        }
+        PickingGrid& getPicking() {
+            return picking;
+        }
+        DronePool& getDronePool() {
+            return dronePool;
+        }
+        TileGrid& getTiles() {
+            return tiles;
+        }
+        InterceptionBuffers& getInterceptionBuffers() {
+            return interception;
+        }
+        Utils::WorkerPool& getWorkers() {
+            return workers;
+        }
+        Utils::Random& getRandom() {
+            return random;
+        }
+        std::uint64_t getDroneHash() const {
+            return droneHash;
+        }
         const EntityID& getGameStateEntityID() const {
             return gameStateEntityID;
         }
         Entity& getGameStateEntity() {
             return coreManager.getEntity(gameStateEntityID);
         }
-        Entity& getAIEntity() {
-            return coreManager.getEntity(AIEntityID);
+        Components::GameStateComponent* getGameState() {
+            if (!coreManager.hasEntity(gameStateEntityID)) {
+                return nullptr;
+            }
+            return coreManager.getEntity(gameStateEntityID).getComponent<Components::GameStateComponent>();
+        }
+        const std::vector<EntityID>& getAIEntities() const {
+            return aiEntities;
+        }
+
+        // Simulation clock, stored in the game state so it travels with the rest of the match.
+        // Absolute times are doubles, a float clock is off by a frame within hours.
+        double getTime() {
+            return getGameStateEntity().getComponent<Components::GameStateComponent>()->time;
+        }
+        std::uint64_t getTick() {
+            return getGameStateEntity().getComponent<Components::GameStateComponent>()->tick;
+        }
+        // One fixed step, the time is derived from the tick instead of summing the steps
+        void advanceTime() {
+            auto* gameState = getGameStateEntity().getComponent<Components::GameStateComponent>();
+            gameState->tick++;
+            gameState->time = getTickTime(gameState->tick);
+        }
+        static double getTickTime(std::uint64_t tick) {
+            return static_cast<double>(tick) * Config::SIMULATION_STEP_SEC;
         }
     };
 }
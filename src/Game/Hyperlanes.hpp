@@ -0,0 +1,392 @@
+#ifndef HYPERLANES_HPP
+#define HYPERLANES_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+
+namespace Game {
+
+    // Optional map mode where drones only fly along lanes between structures.
+    // The lanes are the relative neighbourhood graph of the structures: two structures are joined unless a third one
+    // is closer to both of them than they are to each other. Candidates come from each structure's nearest neighbours.
+    // Shortest paths between every pair are computed once, as the next structure on the way to every target,
+    // so a route is read in the number of lanes it takes and cached per origin and target.
+    // Lanes through structures of another owner are blocked. A faction whose shortest path is blocked gets its own
+    // paths to that target, kept until a capture opens a shortcut or closes a structure they go through.
+    class Hyperlanes {
+    public:
+        using Route = std::vector<sf::Vector2f>;
+        using Next = std::uint16_t;
+        static constexpr Next NONE = std::numeric_limits<Next>::max();
+        static constexpr size_t MAX_STRUCTURES = NONE - 1;
+        static constexpr int CANDIDATES = 10;   // Nearest neighbours tested as lanes
+
+        // Connect the structures and compute every shortest path, drops the previous lanes
+        void build(const std::vector<EntityID>& ids, const std::vector<sf::Vector2f>& positions, const std::vector<Components::Faction>& owners) {
+            clear();
+            if (ids.size() < 2 || ids.size() > MAX_STRUCTURES) {
+                return;
+            }
+            nodePositions = positions;
+            factions = owners;
+            for (size_t node = 0; node < ids.size(); ++node) {
+                index.emplace(ids[node], static_cast<int>(node));
+            }
+            connect();
+            next.assign(static_cast<size_t>(nodeCount()) * nodeCount(), NONE);
+            std::vector<float> distance;
+            for (int target = 0; target < nodeCount(); ++target) {
+                search(target, nullptr, distance, &next[static_cast<size_t>(target) * nodeCount()]);
+            }
+        }
+
+        void clear() {
+            index.clear();
+            nodePositions.clear();
+            factions.clear();
+            laneOffsets.clear();
+            lanes.clear();
+            laneLengths.clear();
+            next.clear();
+            routes.clear();
+            detours.clear();
+        }
+
+        bool isEnabled() const {
+            return !next.empty();
+        }
+
+        // Hand a structure over on capture, only the detours it opens or closes are dropped
+        void setFaction(EntityID id, Components::Faction faction) {
+            auto it = index.find(id);
+            if (it == index.end() || factions[it->second] == faction) {
+                return;
+            }
+            int node = it->second;
+            Components::Faction previous = factions[node];
+            factions[node] = faction;
+
+            for (auto detour = detours.begin(); detour != detours.end();) {
+                auto traveller = static_cast<Components::Faction>(detour->first >> 32);
+                bool wasOpen = isOpen(traveller, previous);
+                bool isOpenNow = isOpen(traveller, faction);
+                bool stale = (wasOpen && !isOpenNow && detour->second.relays[node])
+                          || (!wasOpen && isOpenNow && detour->second.distance[node] < std::numeric_limits<float>::infinity());
+                detour = stale ? detours.erase(detour) : std::next(detour);
+            }
+        }
+
+        // Corners from origin to target along the lanes, the last one is the target.
+        // Null when the structures are unknown or the same, the drone then flies straight.
+        std::shared_ptr<const Route> getRoute(Components::Faction faction, EntityID origin, EntityID target) {
+            auto from = index.find(origin);
+            auto to = index.find(target);
+            if (!isEnabled() || from == index.end() || to == index.end() || from == to) {
+                return nullptr;
+            }
+            int start = from->second;
+            int goal = to->second;
+            const Next* row = &next[static_cast<size_t>(goal) * nodeCount()];
+            if (row[start] == NONE) {
+                return nullptr;
+            }
+
+            // Shortest path, unless a structure on the way belongs to someone else
+            bool blocked = false;
+            for (int node = row[start]; node != goal && !blocked; node = row[node]) {
+                blocked = !isOpen(faction, factions[node]);
+            }
+            if (!blocked) {
+                return findRoute(routes, static_cast<std::uint64_t>(start) * nodeCount() + goal, row, start, goal);
+            }
+
+            Detour& detour = getDetour(faction, goal);
+            if (detour.next[start] == NONE) {
+                // Walled in, fly the shortest path through the blocking structures
+                return findRoute(routes, static_cast<std::uint64_t>(start) * nodeCount() + goal, row, start, goal);
+            }
+            return findRoute(detour.routes, static_cast<std::uint64_t>(start), detour.next.data(), start, goal);
+        }
+
+        size_t getLaneCount() const {
+            return lanes.size() / 2;
+        }
+
+        size_t getDetourCount() const {
+            return detours.size();
+        }
+
+        size_t getTableBytes() const {
+            return next.size() * sizeof(Next);
+        }
+
+        // Call back with the end points of every lane
+        template<typename Callback>
+        void forEachLane(Callback callback) const {
+            for (int node = 0; node < nodeCount(); ++node) {
+                for (int lane = laneOffsets[node]; lane < laneOffsets[node + 1]; ++lane) {
+                    if (lanes[lane] > node) {
+                        callback(nodePositions[node], nodePositions[lanes[lane]]);
+                    }
+                }
+            }
+        }
+
+    private:
+        // Paths to one target for a faction that cannot take the shortest ones
+        struct Detour {
+            std::vector<Next> next;
+            std::vector<float> distance;
+            std::vector<bool> relays;   // Structures some path goes through
+            std::unordered_map<std::uint64_t, std::shared_ptr<const Route>> routes;
+        };
+
+        std::unordered_map<EntityID, int> index;
+        std::vector<sf::Vector2f> nodePositions;
+        std::vector<Components::Faction> factions;
+        std::vector<int> laneOffsets;   // Lanes of each structure, compressed rows
+        std::vector<int> lanes;
+        std::vector<float> laneLengths;
+        std::vector<Next> next;         // Per target, the next structure from every structure
+        std::unordered_map<std::uint64_t, std::shared_ptr<const Route>> routes;
+        std::unordered_map<std::uint64_t, Detour> detours;  // Per faction and target
+
+        int nodeCount() const {
+            return static_cast<int>(nodePositions.size());
+        }
+
+        static bool isOpen(Components::Faction traveller, Components::Faction owner) {
+            return owner == Components::Faction::NEUTRAL || owner == traveller;
+        }
+
+        float getLength(int first, int second) const {
+            sf::Vector2f delta = nodePositions[second] - nodePositions[first];
+            return std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        }
+
+        // Relative neighbourhood graph over the nearest neighbours, then the pieces it left are joined by their closest pair
+        void connect() {
+            int count = nodeCount();
+            float minX = nodePositions[0].x, minY = nodePositions[0].y, maxX = minX, maxY = minY;
+            for (auto& position : nodePositions) {
+                minX = std::min(minX, position.x);
+                minY = std::min(minY, position.y);
+                maxX = std::max(maxX, position.x);
+                maxY = std::max(maxY, position.y);
+            }
+            // Buckets holding about two structures each
+            float cellSize = std::max(1.f, std::sqrt((maxX - minX + 1.f) * (maxY - minY + 1.f) * 2.f / count));
+            int columns = static_cast<int>((maxX - minX) / cellSize) + 1;
+            int rows = static_cast<int>((maxY - minY) / cellSize) + 1;
+            std::vector<int> bucketStart(columns * rows + 1, 0);
+            std::vector<int> bucketNodes(count);
+            auto getBucket = [&](int node) {
+                int column = std::min(columns - 1, static_cast<int>((nodePositions[node].x - minX) / cellSize));
+                int row = std::min(rows - 1, static_cast<int>((nodePositions[node].y - minY) / cellSize));
+                return row * columns + column;
+            };
+            for (int node = 0; node < count; ++node) {
+                bucketStart[getBucket(node) + 1]++;
+            }
+            for (int bucket = 0; bucket < columns * rows; ++bucket) {
+                bucketStart[bucket + 1] += bucketStart[bucket];
+            }
+            std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+            for (int node = 0; node < count; ++node) {
+                bucketNodes[fill[getBucket(node)]++] = node;
+            }
+
+            std::vector<std::pair<int, int>> edges;
+            std::vector<std::pair<float, int>> nearest;
+            int candidates = std::min(CANDIDATES, count - 1);
+            for (int node = 0; node < count; ++node) {
+                // Grow the ring of buckets until it holds enough structures and the next ring is farther than all of them
+                int bucket = getBucket(node);
+                int column = bucket % columns;
+                int row = bucket / columns;
+                nearest.clear();
+                for (int ring = 0;; ++ring) {
+                    for (int y = row - ring; y <= row + ring; ++y) {
+                        for (int x = column - ring; x <= column + ring; ++x) {
+                            bool onRing = std::abs(y - row) == ring || std::abs(x - column) == ring;
+                            if (!onRing || x < 0 || y < 0 || x >= columns || y >= rows) {
+                                continue;
+                            }
+                            for (int i = bucketStart[y * columns + x]; i < bucketStart[y * columns + x + 1]; ++i) {
+                                if (bucketNodes[i] != node) {
+                                    nearest.emplace_back(getLength(node, bucketNodes[i]), bucketNodes[i]);
+                                }
+                            }
+                        }
+                    }
+                    bool coversGrid = ring >= std::max(columns, rows);
+                    if (static_cast<int>(nearest.size()) >= candidates) {
+                        std::nth_element(nearest.begin(), nearest.begin() + (candidates - 1), nearest.end());
+                        if (nearest[candidates - 1].first <= ring * cellSize || coversGrid) {
+                            break;
+                        }
+                    } else if (coversGrid) {
+                        break;
+                    }
+                }
+                std::sort(nearest.begin(), nearest.end());
+                nearest.resize(candidates);
+
+                // A lane to a candidate survives unless a nearer candidate is also nearer to the other end
+                for (int i = 0; i < candidates; ++i) {
+                    auto [length, other] = nearest[i];
+                    bool keep = true;
+                    for (int j = 0; j < i && keep; ++j) {
+                        keep = std::max(nearest[j].first, getLength(nearest[j].second, other)) >= length;
+                    }
+                    if (keep) {
+                        edges.emplace_back(std::min(node, other), std::max(node, other));
+                    }
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+            joinPieces(edges);
+
+            laneOffsets.assign(count + 1, 0);
+            for (auto& [first, second] : edges) {
+                laneOffsets[first + 1]++;
+                laneOffsets[second + 1]++;
+            }
+            for (int node = 0; node < count; ++node) {
+                laneOffsets[node + 1] += laneOffsets[node];
+            }
+            lanes.assign(edges.size() * 2, 0);
+            laneLengths.assign(edges.size() * 2, 0.f);
+            std::vector<int> cursor(laneOffsets.begin(), laneOffsets.end() - 1);
+            for (auto& [first, second] : edges) {
+                laneLengths[cursor[first]] = laneLengths[cursor[second]] = getLength(first, second);
+                lanes[cursor[first]++] = second;
+                lanes[cursor[second]++] = first;
+            }
+        }
+
+        // Link every piece of the graph to the rest by the shortest possible lane, smallest pieces first
+        void joinPieces(std::vector<std::pair<int, int>>& edges) {
+            int count = nodeCount();
+            std::vector<int> parent(count);
+            for (int node = 0; node < count; ++node) {
+                parent[node] = node;
+            }
+            auto find = [&parent](int node) {
+                while (parent[node] != node) {
+                    node = parent[node] = parent[parent[node]];
+                }
+                return node;
+            };
+            for (auto& [first, second] : edges) {
+                parent[find(first)] = find(second);
+            }
+            for (;;) {
+                std::vector<int> size(count, 0);
+                for (int node = 0; node < count; ++node) {
+                    size[find(node)]++;
+                }
+                int smallest = -1;
+                for (int node = 0; node < count; ++node) {
+                    if (parent[node] == node && size[node] < count && (smallest < 0 || size[node] < size[smallest])) {
+                        smallest = node;
+                    }
+                }
+                if (smallest < 0) {
+                    return;
+                }
+                std::pair<int, int> best{-1, -1};
+                float bestLength = std::numeric_limits<float>::infinity();
+                for (int node = 0; node < count; ++node) {
+                    if (find(node) != smallest) {
+                        continue;
+                    }
+                    for (int other = 0; other < count; ++other) {
+                        if (find(other) != smallest && getLength(node, other) < bestLength) {
+                            bestLength = getLength(node, other);
+                            best = {std::min(node, other), std::max(node, other)};
+                        }
+                    }
+                }
+                edges.push_back(best);
+                parent[find(best.first)] = find(best.second);
+            }
+        }
+
+        // Dijkstra from the target over the lanes, structures closed to the traveller are reached but not passed through.
+        // Fills the next structure towards the target of every structure reached.
+        void search(int target, const Components::Faction* traveller, std::vector<float>& distance, Next* towards) const {
+            distance.assign(nodeCount(), std::numeric_limits<float>::infinity());
+            using Entry = std::pair<float, int>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+            distance[target] = 0.f;
+            towards[target] = static_cast<Next>(target);
+            open.push({0.f, target});
+            while (!open.empty()) {
+                auto [cost, node] = open.top();
+                open.pop();
+                if (cost > distance[node]) {
+                    continue;
+                }
+                if (traveller && node != target && !isOpen(*traveller, factions[node])) {
+                    continue;
+                }
+                for (int lane = laneOffsets[node]; lane < laneOffsets[node + 1]; ++lane) {
+                    int other = lanes[lane];
+                    float length = cost + laneLengths[lane];
+                    if (length < distance[other]) {
+                        distance[other] = length;
+                        towards[other] = static_cast<Next>(node);
+                        open.push({length, other});
+                    }
+                }
+            }
+        }
+
+        Detour& getDetour(Components::Faction faction, int target) {
+            std::uint64_t key = (static_cast<std::uint64_t>(faction) << 32) | static_cast<std::uint32_t>(target);
+            auto it = detours.find(key);
+            if (it != detours.end()) {
+                return it->second;
+            }
+            Detour& detour = detours[key];
+            detour.next.assign(nodeCount(), NONE);
+            search(target, &faction, detour.distance, detour.next.data());
+            detour.relays.assign(nodeCount(), false);
+            for (int node = 0; node < nodeCount(); ++node) {
+                if (detour.next[node] != NONE && detour.next[node] != target && detour.next[node] != node) {
+                    detour.relays[detour.next[node]] = true;
+                }
+            }
+            return detour;
+        }
+
+        std::shared_ptr<const Route> findRoute(std::unordered_map<std::uint64_t, std::shared_ptr<const Route>>& cache, std::uint64_t key, const Next* towards, int start, int goal) {
+            auto it = cache.find(key);
+            if (it == cache.end()) {
+                auto route = std::make_shared<Route>();
+                for (int node = towards[start]; ; node = towards[node]) {
+                    route->push_back(nodePositions[node]);
+                    if (node == goal) {
+                        break;
+                    }
+                }
+                it = cache.emplace(key, std::move(route)).first;
+            }
+            return it->second;
+        }
+    };
+}
+
+#endif // HYPERLANES_HPP
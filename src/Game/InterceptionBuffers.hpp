@@ -0,0 +1,29 @@
+#ifndef INTERCEPTION_BUFFERS_HPP
+#define INTERCEPTION_BUFFERS_HPP
+
+#include <vector>
+#include <unordered_set>
+
+#include "Core/EntityManager.hpp"
+#include "Utils/SpatialHash.hpp"
+
+namespace Game {
+
+    // Scratch space of the interception system, kept per match so the lists keep their capacity from tick to tick
+    // and two matches in one process never share them. Nothing in here outlives the tick that filled it.
+    struct InterceptionBuffers {
+        struct Contact {
+            float time;     // Since the previous tick
+            EntityID first;
+            EntityID second;
+        };
+
+        Utils::SpatialHash hash;
+        std::vector<Contact> contacts;
+        std::vector<std::vector<Contact>> tileContacts;   // One list per map tile, written by one task each
+        std::vector<EntityID> destroyed;
+        std::unordered_set<EntityID> resolved;
+    };
+}
+
+#endif // INTERCEPTION_BUFFERS_HPP
@@ -3,18 +3,17 @@
 
 #include <vector>
 #include <cmath>
-#include <random>
 #include <SFML/System/Vector2.hpp> // Include sf::Vector2f
 
 #include "Game/GameEntityManager.hpp"
+#include "Utils/Random.hpp"
 
 namespace Game {
 
     class RandomPositionGenerator {
     public:
-        RandomPositionGenerator(float mapWidth, float mapHeight, float minDistance)
-            : mapWidth(mapWidth), mapHeight(mapHeight), minDistance(minDistance),
-              gen(rd()), distX(0.0f, mapWidth), distY(0.0f, mapHeight) {}
+        RandomPositionGenerator(Utils::Random& random, float mapWidth, float mapHeight, float minDistance)
+            : random(random), mapWidth(mapWidth), mapHeight(mapHeight), minDistance(minDistance) {}
 
         std::vector<sf::Vector2f> generateNonOverlappingPositions(int unitCount) {
             std::vector<sf::Vector2f> positions;
@@ -22,7 +21,7 @@ namespace Game {
             int attempts = 0;
 
             while (positions.size() < unitCount && attempts < maxAttempts) {
-                sf::Vector2f newPos = {distX(gen), distY(gen)};
+                sf::Vector2f newPos = {random.getFloat(0.0f, mapWidth), random.getFloat(0.0f, mapHeight)};
                 if (!isOverlapping(newPos, positions)) {
                     positions.push_back(newPos);
                 }
@@ -33,11 +32,8 @@ namespace Game {
         }
 
     private:
+        Utils::Random& random;
         float mapWidth, mapHeight, minDistance;
-        std::random_device rd;
-        std::mt19937 gen;
-        std::uniform_real_distribution<float> distX;
-        std::uniform_real_distribution<float> distY;
 
         bool isOverlapping(const sf::Vector2f& pos, const std::vector<sf::Vector2f>& positions) {
             for (const auto& other : positions) {
@@ -58,67 +54,106 @@ namespace Game {
         return std::sqrt(dx * dx + dy * dy);
     }
 
-    void GenerateRandomMap(Game::GameEntityManager& entityManager, float mapWidth, float mapHeight, int unitCount, float minDistance) {
+    // Connect every structure into hyperlanes, drones of the match then fly along them
+    void ConnectHyperlanes(Game::GameEntityManager& entityManager) {
+        std::vector<EntityID> ids;
+        std::vector<sf::Vector2f> positions;
+        std::vector<Components::Faction> owners;
+        for (EntityID id : entityManager.getGarissons()) {
+            auto* transform = entityManager.getComponent<Components::TransformComponent>(id);
+            auto* faction = entityManager.getComponent<Components::FactionComponent>(id);
+            if (transform) {
+                ids.push_back(id);
+                positions.push_back(transform->getPosition());
+                owners.push_back(faction ? faction->faction : Components::Faction::NEUTRAL);
+            }
+        }
+        entityManager.getHyperlanes().build(ids, positions, owners);
+    }
+
+    // Measure the distance between every pair of structures once, they never move
+    void BuildDistanceTable(Game::GameEntityManager& entityManager) {
+        std::vector<EntityID> ids;
+        std::vector<sf::Vector2f> positions;
+        for (EntityID id : entityManager.getGarissons()) {
+            if (auto* transform = entityManager.getComponent<Components::TransformComponent>(id)) {
+                ids.push_back(id);
+                positions.push_back(transform->getPosition());
+            }
+        }
+        entityManager.getDistances().build(ids, positions);
+    }
+
+    void GenerateRandomMap(Game::GameEntityManager& entityManager, float mapWidth, float mapHeight, int unitCount, float minDistance, unsigned int playerCount = 2, bool hyperlanes = false) {
         float minPlayerDistance = 700.0f; // Minimum distance between players
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> distX(0.0f, mapWidth);
-        std::uniform_real_distribution<float> distY(0.0f, mapHeight);
+        // Every draw comes from the world's seeded generator, the seed reproduces the map
+        auto& random = entityManager.getRandom();
 
-        // Generate starting positions for Player 1 and Player 2
-        sf::Vector2f player1Start, player2Start;
+        // Generate starting positions for every player
+        std::vector<sf::Vector2f> playerStarts(playerCount);
         bool validPlacement = false;
+        int attempts = 0;
 
         while (!validPlacement) {
-            player1Start = {distX(gen), distY(gen)};
-            player2Start = {distX(gen), distY(gen)};
+            for (auto& start : playerStarts) {
+                start = {random.getFloat(0.0f, mapWidth), random.getFloat(0.0f, mapHeight)};
+            }
 
-            // Ensure players are sufficiently far apart
-            if (calculateDistance(player1Start, player2Start) >= minPlayerDistance) {
-                validPlacement = true;
+            // Ensure players are sufficiently far apart, many players may have to settle for less
+            validPlacement = true;
+            for (size_t i = 0; i < playerStarts.size() && validPlacement; ++i) {
+                for (size_t j = i + 1; j < playerStarts.size() && validPlacement; ++j) {
+                    validPlacement = calculateDistance(playerStarts[i], playerStarts[j]) >= minPlayerDistance;
+                }
+            }
+            if (++attempts % 100 == 0) {
+                minPlayerDistance *= 0.9f;
             }
         }
 
-        // Place Player 1 Structures (Factory + Power Plant)
-        sf::Vector2f player1FactoryPos = player1Start;
-        sf::Vector2f player1PowerPlantPos = {player1Start.x + Utils::getRandomFloat(50.f, 150.f), player1Start.y + Utils::getRandomFloat(50.f, 150.f)};
-
-        auto player1Faction = Components::Faction::PLAYER_1;
+        // Place each player's structures (Factory + Power Plant), every player starts with the same ones
         float productionRate = 1.f;
-        float shieldRegenRate = Utils::getRandomFloat(0.75f, 1.f);
-        unsigned int capacity = Utils::getRandomFloat(13.f, 20.f);
-
-        Game::createFactory(entityManager, "Factory #0", player1FactoryPos, player1Faction, productionRate, shieldRegenRate);
-        Game::createPowerPlant(entityManager, "Power Plant #0", player1PowerPlantPos, player1Faction, shieldRegenRate, capacity);
+        float shieldRegenRate = 0.f;
+        unsigned int capacity = 0;
 
-        // Place Player 2 Structures (Factory + Power Plant)
-        sf::Vector2f player2FactoryPos = player2Start;
-        sf::Vector2f player2PowerPlantPos = {player2Start.x + Utils::getRandomFloat(50.f, 150.f), player2Start.y + Utils::getRandomFloat(50.f, 150.f)};
+        for (unsigned int player = 0; player < playerCount; ++player) {
+            sf::Vector2f factoryPos = playerStarts[player];
+            sf::Vector2f powerPlantPos = {factoryPos.x + random.getFloat(50.f, 150.f), factoryPos.y + random.getFloat(50.f, 150.f)};
 
-        auto player2Faction = Components::Faction::PLAYER_2;
+            if (player == 0) {
+                shieldRegenRate = random.getFloat(0.75f, 1.f);
+                capacity = random.getFloat(13.f, 20.f);
+            }
 
-        Game::createFactory(entityManager, "Factory #0", player2FactoryPos, player2Faction, productionRate, shieldRegenRate);
-        Game::createPowerPlant(entityManager, "Power Plant #0", player2PowerPlantPos, player2Faction, shieldRegenRate, capacity);
+            auto faction = Components::getPlayerFaction(player + 1);
+            Game::createFactory(entityManager, "Factory #0", factoryPos, faction, productionRate, shieldRegenRate);
+            Game::createPowerPlant(entityManager, "Power Plant #0", powerPlantPos, faction, shieldRegenRate, capacity);
+        }
 
         // Generate Remaining Units Randomly
-        Game::RandomPositionGenerator generator(mapWidth, mapHeight, minDistance);
+        Game::RandomPositionGenerator generator(random, mapWidth, mapHeight, minDistance);
         auto positions = generator.generateNonOverlappingPositions(unitCount); // Adjust count as needed
 
         for (size_t i = 0; i < positions.size(); ++i) {
-            float coinFlip = Utils::getRandomFloat(0.f, 1.f);
-            float shieldRegenRate = Utils::getRandomFloat(0.1f, 1.f);
+            float coinFlip = random.getFloat(0.f, 1.f);
+            float shieldRegenRate = random.getFloat(0.1f, 1.f);
 
             if (coinFlip > 0.5f) {
                 // Generate Factory
-                auto productionRate = Utils::getRandomFloat(0.1f, 0.9f);
+                auto productionRate = random.getFloat(0.1f, 0.9f);
                 Game::createFactory(entityManager, "Factory #" + std::to_string(i), positions[i], Components::Faction::NEUTRAL, productionRate, shieldRegenRate);
             } else {
                 // Generate Power plant
-                unsigned int capacity = Utils::getRandomFloat(5.f, 25.f);
+                unsigned int capacity = random.getFloat(5.f, 25.f);
                 Game::createPowerPlant(entityManager, "Power Plant #" + std::to_string(i), positions[i], Components::Faction::NEUTRAL, shieldRegenRate, capacity);
             }
         }
+
+        BuildDistanceTable(entityManager);
+        if (hyperlanes) {
+            ConnectHyperlanes(entityManager);
+        }
     }
 
 }
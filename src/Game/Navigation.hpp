@@ -0,0 +1,249 @@
+#ifndef NAVIGATION_HPP
+#define NAVIGATION_HPP
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Obstacle-aware routes for drones.
+    // Structures are rasterised onto a coarse grid. For every target a flow field (cost to the target from every cell)
+    // is built the first time a drone heads there and shared by every drone flying to it.
+    // Drones only read the field at launch: the cells from the start cell are string-pulled into a few corners,
+    // cached per origin and start cell, so a flight stays a closed-form function of time and costs nothing per tick.
+    // Adding or removing a structure drops the grid and every cached field.
+    class Navigation {
+    public:
+        using Route = std::vector<sf::Vector2f>;
+
+        void addObstacle(EntityID id, sf::Vector2f position, float radius) {
+            obstacles[id] = Obstacle{position, radius};
+            dirty = true;
+        }
+
+        void removeObstacle(EntityID id) {
+            if (obstacles.erase(id) > 0) {
+                dirty = true;
+            }
+        }
+
+        // Corners to fly through after leaving `from`, the last one is `to`.
+        // Null when the straight line only crosses the origin and the target.
+        std::shared_ptr<const Route> getRoute(EntityID origin, EntityID target, sf::Vector2f from, sf::Vector2f to) {
+            if (dirty) {
+                rebuild();
+            }
+            if (isClear(from, to, origin, target)) {
+                return nullptr;
+            }
+
+            FlowField& field = getField(target);
+            int start = getCell(from);
+            std::uint64_t key = static_cast<std::uint64_t>(origin) * cells() + start;
+            auto route = findRoute(field, key, [&]() { return buildRoute(field, origin, target, start, to); });
+
+            // Routes start at the cell center, a drone launched off center that cannot see the first corner goes there first
+            if (!isClear(from, route->front(), origin, target)) {
+                route = findRoute(field, key | DETOUR_KEY, [&]() {
+                    Route detour{getCenter(start)};
+                    detour.insert(detour.end(), route->begin(), route->end());
+                    return detour;
+                });
+            }
+            return route;
+        }
+
+        size_t getFieldCount() const {
+            return fields.size();
+        }
+
+    private:
+        struct Obstacle {
+            sf::Vector2f position;
+            float radius;
+        };
+
+        struct FlowField {
+            std::vector<float> cost;            // Cost to the target
+            std::vector<std::int8_t> next;      // Direction to the cheaper neighbour, -1 at the target
+            std::unordered_map<std::uint64_t, std::shared_ptr<const Route>> routes;
+        };
+
+        static constexpr int DIRECTIONS = 8;
+        // Opposite directions are paired, direction ^ 1 turns around
+        static constexpr int DX[DIRECTIONS] = {1, -1, 0, 0, 1, -1, 1, -1};
+        static constexpr int DY[DIRECTIONS] = {0, 0, 1, -1, 1, -1, -1, 1};
+        static constexpr std::uint64_t DETOUR_KEY = 1ULL << 63;
+        // Crossing a structure is allowed, but only as a last resort and to leave the one a drone starts in
+        static constexpr float OBSTACLE_COST = 25.f;
+
+        std::map<EntityID, Obstacle> obstacles;
+        bool dirty = true;
+        int columns = 0;
+        int rows = 0;
+        std::vector<EntityID> owner;    // Structure covering each cell, 0 when free
+        std::unordered_map<EntityID, FlowField> fields;
+
+        int cells() const {
+            return columns * rows;
+        }
+
+        int getCell(sf::Vector2f position) const {
+            int column = std::clamp(static_cast<int>(std::floor(position.x / Config::NAVIGATION_CELL_SIZE)), 0, columns - 1);
+            int row = std::clamp(static_cast<int>(std::floor(position.y / Config::NAVIGATION_CELL_SIZE)), 0, rows - 1);
+            return row * columns + column;
+        }
+
+        sf::Vector2f getCenter(int cell) const {
+            return {(cell % columns + 0.5f) * Config::NAVIGATION_CELL_SIZE, (cell / columns + 0.5f) * Config::NAVIGATION_CELL_SIZE};
+        }
+
+        void rebuild() {
+            columns = static_cast<int>(std::ceil(Config::MAP_WIDTH / Config::NAVIGATION_CELL_SIZE));
+            rows = static_cast<int>(std::ceil(Config::MAP_HEIGHT / Config::NAVIGATION_CELL_SIZE));
+            owner.assign(cells(), 0);
+            fields.clear();
+
+            for (auto& [id, obstacle] : obstacles) {
+                float reach = obstacle.radius + Config::NAVIGATION_CLEARANCE;
+                int first = getCell(obstacle.position - sf::Vector2f(reach, reach));
+                int last = getCell(obstacle.position + sf::Vector2f(reach, reach));
+                for (int row = first / columns; row <= last / columns; ++row) {
+                    for (int column = first % columns; column <= last % columns; ++column) {
+                        int cell = row * columns + column;
+                        sf::Vector2f delta = getCenter(cell) - obstacle.position;
+                        if (owner[cell] == 0 && delta.x * delta.x + delta.y * delta.y <= reach * reach) {
+                            owner[cell] = id;
+                        }
+                    }
+                }
+            }
+            dirty = false;
+        }
+
+        bool isPassable(int cell, EntityID origin, EntityID target) const {
+            return owner[cell] == 0 || owner[cell] == origin || owner[cell] == target;
+        }
+
+        // Sampled at a third of a cell, fine enough not to skip a cell corner of note
+        bool isClear(sf::Vector2f from, sf::Vector2f to, EntityID origin, EntityID target) const {
+            sf::Vector2f delta = to - from;
+            float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            int samples = static_cast<int>(length / (Config::NAVIGATION_CELL_SIZE / 3.f)) + 1;
+            for (int i = 0; i <= samples; ++i) {
+                if (!isPassable(getCell(from + delta * (static_cast<float>(i) / samples)), origin, target)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Dijkstra from every cell of the target outwards
+        FlowField& getField(EntityID target) {
+            auto it = fields.find(target);
+            if (it != fields.end()) {
+                return it->second;
+            }
+
+            FlowField& field = fields[target];
+            field.cost.assign(cells(), std::numeric_limits<float>::infinity());
+            field.next.assign(cells(), -1);
+
+            using Entry = std::pair<float, int>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+            for (int cell = 0; cell < cells(); ++cell) {
+                if (owner[cell] == target) {
+                    field.cost[cell] = 0.f;
+                    open.push({0.f, cell});
+                }
+            }
+            if (open.empty()) {
+                auto obstacle = obstacles.find(target);
+                int cell = obstacle != obstacles.end() ? getCell(obstacle->second.position) : 0;
+                field.cost[cell] = 0.f;
+                open.push({0.f, cell});
+            }
+
+            while (!open.empty()) {
+                auto [cost, cell] = open.top();
+                open.pop();
+                if (cost > field.cost[cell]) {
+                    continue;
+                }
+                int column = cell % columns;
+                int row = cell / columns;
+                for (int direction = 0; direction < DIRECTIONS; ++direction) {
+                    int nextColumn = column + DX[direction];
+                    int nextRow = row + DY[direction];
+                    if (nextColumn < 0 || nextColumn >= columns || nextRow < 0 || nextRow >= rows) {
+                        continue;
+                    }
+                    int neighbour = nextRow * columns + nextColumn;
+                    float step = direction < 4 ? 1.f : 1.41421356f;
+                    if (owner[neighbour] != 0 && owner[neighbour] != target) {
+                        step *= OBSTACLE_COST;
+                    }
+                    if (cost + step < field.cost[neighbour]) {
+                        field.cost[neighbour] = cost + step;
+                        // Opposite direction, from the neighbour back to this cell
+                        field.next[neighbour] = static_cast<std::int8_t>(direction ^ 1);
+                        open.push({cost + step, neighbour});
+                    }
+                }
+            }
+            return field;
+        }
+
+        template<typename Build>
+        std::shared_ptr<const Route> findRoute(FlowField& field, std::uint64_t key, Build build) {
+            auto it = field.routes.find(key);
+            if (it == field.routes.end()) {
+                it = field.routes.emplace(key, std::make_shared<const Route>(build())).first;
+            }
+            return it->second;
+        }
+
+        // Follow the field from the start cell and keep only the corners where the line of sight breaks
+        Route buildRoute(const FlowField& field, EntityID origin, EntityID target, int start, sf::Vector2f to) const {
+            std::vector<sf::Vector2f> path{getCenter(start)};
+            int cell = start;
+            for (int guard = 0; field.next[cell] >= 0 && guard < cells(); ++guard) {
+                cell += DY[field.next[cell]] * columns + DX[field.next[cell]];
+                path.push_back(getCenter(cell));
+            }
+            path.back() = to;
+
+            Route route;
+            size_t anchor = 0;
+            while (anchor + 1 < path.size()) {
+                size_t farthest = anchor + 1;
+                for (size_t i = path.size() - 1; i > anchor + 1; --i) {
+                    if (isClear(path[anchor], path[i], origin, target)) {
+                        farthest = i;
+                        break;
+                    }
+                }
+                route.push_back(path[farthest]);
+                anchor = farthest;
+            }
+            if (route.empty()) {
+                route.push_back(to);
+            }
+            return route;
+        }
+    };
+}
+
+#endif // NAVIGATION_HPP
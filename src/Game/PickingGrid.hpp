@@ -0,0 +1,181 @@
+#ifndef PICKING_GRID_HPP
+#define PICKING_GRID_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Uniform grid over the map holding the bounds of the entities the mouse can hover or select, drones are not in it.
+    // An entity is listed in every cell its bounds overlap. Structures span a cell or two, so a point query reads
+    // one short cell list whatever the number of entities. Entities off the map go to the border cells.
+    class PickingGrid {
+    public:
+        enum Flags : unsigned char {
+            HOVERABLE = 1,
+            SELECTABLE = 2
+        };
+
+        PickingGrid() {
+            columns = static_cast<int>(std::ceil(Config::MAP_WIDTH / Config::PICKING_CELL_SIZE));
+            rows = static_cast<int>(std::ceil(Config::MAP_HEIGHT / Config::PICKING_CELL_SIZE));
+            cells.resize(columns * rows);
+        }
+
+        void insert(EntityID id, const sf::FloatRect& bounds, unsigned char flags) {
+            auto it = items.find(id);
+            if (it != items.end()) {
+                unlink(id, it->second.bounds);
+            }
+            items[id] = Item{bounds, flags};
+            forEachCell(bounds, [&](int column, int row) {
+                cells[getCell(column, row)].push_back(id);
+            });
+        }
+
+        // New bounds after the entity moved or turned
+        void move(EntityID id, const sf::FloatRect& bounds) {
+            auto it = items.find(id);
+            if (it != items.end()) {
+                insert(id, bounds, it->second.flags);
+            }
+        }
+
+        void remove(EntityID id) {
+            auto it = items.find(id);
+            if (it == items.end()) {
+                return;
+            }
+            unlink(id, it->second.bounds);
+            items.erase(it);
+            hovered.erase(std::remove(hovered.begin(), hovered.end(), id), hovered.end());
+        }
+
+        // Entity with the flags under the point, the one whose center is closest where bounds overlap, 0 if none
+        EntityID pick(sf::Vector2f point, unsigned char flags) const {
+            EntityID best = 0;
+            float bestDistance = 0.f;
+            for (EntityID id : cells[getCell(getColumn(point.x), getRow(point.y))]) {
+                const Item& item = items.at(id);
+                if ((item.flags & flags) != flags || !item.bounds.contains(point)) {
+                    continue;
+                }
+                float dx = item.bounds.left + item.bounds.width / 2.f - point.x;
+                float dy = item.bounds.top + item.bounds.height / 2.f - point.y;
+                float distance = dx * dx + dy * dy;
+                if (best == 0 || distance < bestDistance || (distance == bestDistance && id < best)) {
+                    best = id;
+                    bestDistance = distance;
+                }
+            }
+            return best;
+        }
+
+        // Every entity with the flags under the point, in ID order
+        void pickAll(sf::Vector2f point, unsigned char flags, std::vector<EntityID>& result) const {
+            size_t first = result.size();
+            for (EntityID id : cells[getCell(getColumn(point.x), getRow(point.y))]) {
+                const Item& item = items.at(id);
+                if ((item.flags & flags) == flags && item.bounds.contains(point)) {
+                    result.push_back(id);
+                }
+            }
+            std::sort(result.begin() + first, result.end());
+        }
+
+        // Entities with the flags whose bounds overlap the area, each once
+        void query(const sf::FloatRect& area, unsigned char flags, std::vector<EntityID>& result) const {
+            int left = getColumn(area.left);
+            int top = getRow(area.top);
+            forEachCell(area, [&](int column, int row) {
+                for (EntityID id : cells[getCell(column, row)]) {
+                    const Item& item = items.at(id);
+                    if ((item.flags & flags) != flags || !item.bounds.intersects(area)) {
+                        continue;
+                    }
+                    // Reported from the first cell the entity and the area share only
+                    if (column == std::max(left, getColumn(item.bounds.left)) && row == std::max(top, getRow(item.bounds.top))) {
+                        result.push_back(id);
+                    }
+                }
+            });
+        }
+
+        // Call back with the ID of every entity with the flags
+        template<typename Callback>
+        void forEach(unsigned char flags, Callback callback) const {
+            for (auto& [id, item] : items) {
+                if ((item.flags & flags) == flags) {
+                    callback(id);
+                }
+            }
+        }
+
+        // Entities under the mouse as of the last hover pass
+        const std::vector<EntityID>& getHovered() const {
+            return hovered;
+        }
+        void setHovered(const std::vector<EntityID>& ids) {
+            hovered = ids;
+        }
+
+        size_t size() const {
+            return items.size();
+        }
+
+        void clear() {
+            items.clear();
+            hovered.clear();
+            for (auto& cell : cells) {
+                cell.clear();
+            }
+        }
+
+    private:
+        struct Item {
+            sf::FloatRect bounds;
+            unsigned char flags;
+        };
+
+        int columns = 1;
+        int rows = 1;
+        std::vector<std::vector<EntityID>> cells;
+        std::unordered_map<EntityID, Item> items;
+        std::vector<EntityID> hovered;
+
+        int getColumn(float x) const {
+            return std::clamp(static_cast<int>(std::floor(x / Config::PICKING_CELL_SIZE)), 0, columns - 1);
+        }
+        int getRow(float y) const {
+            return std::clamp(static_cast<int>(std::floor(y / Config::PICKING_CELL_SIZE)), 0, rows - 1);
+        }
+        size_t getCell(int column, int row) const {
+            return static_cast<size_t>(row * columns + column);
+        }
+
+        void unlink(EntityID id, const sf::FloatRect& bounds) {
+            forEachCell(bounds, [&](int column, int row) {
+                auto& cell = cells[getCell(column, row)];
+                cell.erase(std::remove(cell.begin(), cell.end(), id), cell.end());
+            });
+        }
+
+        // Call visit(column, row) for the cells a rectangle overlaps
+        template<typename Visit>
+        void forEachCell(const sf::FloatRect& bounds, Visit visit) const {
+            for (int row = getRow(bounds.top); row <= getRow(bounds.top + bounds.height); ++row) {
+                for (int column = getColumn(bounds.left); column <= getColumn(bounds.left + bounds.width); ++column) {
+                    visit(column, row);
+                }
+            }
+        }
+    };
+}
+
+#endif // PICKING_GRID_HPP
@@ -0,0 +1,359 @@
+#ifndef POWER_GRID_HPP
+#define POWER_GRID_HPP
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Power plants only supply the factories they are linked to through a chain of structures of the same owner,
+    // two structures are linked when they are within the link radius. Structures never move, the links are found
+    // once when a structure is added, the grids of each owner are kept as sets of a union-find.
+    // Joining a grid on capture unions with the new owner's linked neighbours. Leaving one abandons the structure's
+    // set element and hands it a fresh one, a structure with at most one link in its old grid cannot split it,
+    // otherwise the pieces that broke off are searched for and moved to sets of their own, the largest piece stays.
+    // Abandoned elements are compacted away once they outnumber the structures.
+    // Each set also sums the drones parked in the grid, the drones its power plants have to supply.
+    class PowerGrid {
+    public:
+        void addStructure(EntityID id, sf::Vector2f position, Components::Faction faction, unsigned int capacity) {
+            if (index.count(id) > 0) {
+                setFaction(id, faction);
+                return;
+            }
+            int node = static_cast<int>(nodes.size());
+            nodes.push_back(Node{id, position, Components::Faction::NEUTRAL, static_cast<int>(capacity), 0, newElement(static_cast<int>(capacity), 0), {}});
+            searchOf.push_back(-1);
+            index.emplace(id, node);
+
+            // Link to the structures in the 3x3 buckets of link radius around this one
+            auto [column, row] = getBucket(position);
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    auto bucket = buckets.find(getKey(column + dx, row + dy));
+                    if (bucket == buckets.end()) {
+                        continue;
+                    }
+                    for (int other : bucket->second) {
+                        sf::Vector2f delta = nodes[other].position - position;
+                        if (delta.x * delta.x + delta.y * delta.y <= Config::POWER_LINK_RADIUS * Config::POWER_LINK_RADIUS) {
+                            nodes[node].links.push_back(other);
+                            nodes[other].links.push_back(node);
+                        }
+                    }
+                }
+            }
+            buckets[getKey(column, row)].push_back(node);
+            join(node, faction);
+        }
+
+        void removeStructure(EntityID id) {
+            auto it = index.find(id);
+            if (it == index.end()) {
+                return;
+            }
+            int node = it->second;
+            leave(node);
+            for (int other : nodes[node].links) {
+                auto& links = nodes[other].links;
+                links.erase(std::remove(links.begin(), links.end(), node), links.end());
+            }
+            nodes[node].links.clear();
+            auto [column, row] = getBucket(nodes[node].position);
+            auto& bucket = buckets[getKey(column, row)];
+            bucket.erase(std::remove(bucket.begin(), bucket.end(), node), bucket.end());
+            index.erase(it);
+        }
+
+        // Hand a structure over on capture
+        void setFaction(EntityID id, Components::Faction faction) {
+            auto it = index.find(id);
+            if (it == index.end() || nodes[it->second].faction == faction) {
+                return;
+            }
+            leave(it->second);
+            join(it->second, faction);
+            if (elements.size() > 2 * nodes.size() + 64) {
+                compact();
+            }
+        }
+
+        // Energy capacity of the grid a structure belongs to, 0 for neutral structures
+        int getCapacity(EntityID id) {
+            auto it = index.find(id);
+            if (it == index.end() || nodes[it->second].faction == Components::Faction::NEUTRAL) {
+                return 0;
+            }
+            return elements[find(nodes[it->second].element)].capacity;
+        }
+
+        // Drones parked at the structures of the grid a structure belongs to, 0 for neutral structures
+        int getDrones(EntityID id) {
+            auto it = index.find(id);
+            if (it == index.end() || nodes[it->second].faction == Components::Faction::NEUTRAL) {
+                return 0;
+            }
+            return elements[find(nodes[it->second].element)].drones;
+        }
+
+        void setDrones(EntityID id, unsigned int count) {
+            auto it = index.find(id);
+            if (it == index.end()) {
+                return;
+            }
+            Node& node = nodes[it->second];
+            elements[find(node.element)].drones += static_cast<int>(count) - node.drones;
+            node.drones = static_cast<int>(count);
+        }
+
+        bool isConnected(EntityID first, EntityID second) {
+            auto a = index.find(first);
+            auto b = index.find(second);
+            if (a == index.end() || b == index.end() || nodes[a->second].faction == Components::Faction::NEUTRAL) {
+                return false;
+            }
+            return nodes[a->second].faction == nodes[b->second].faction && find(nodes[a->second].element) == find(nodes[b->second].element);
+        }
+
+        // Structures within link radius of a structure, whoever owns them
+        std::vector<EntityID> getLinks(EntityID id) const {
+            std::vector<EntityID> result;
+            auto it = index.find(id);
+            if (it != index.end()) {
+                for (int other : nodes[it->second].links) {
+                    result.push_back(nodes[other].id);
+                }
+            }
+            return result;
+        }
+
+        // Call back with the end points of every link between two structures of the faction
+        template<typename Callback>
+        void forEachLink(Components::Faction faction, Callback callback) const {
+            for (size_t node = 0; node < nodes.size(); ++node) {
+                if (nodes[node].faction != faction) {
+                    continue;
+                }
+                for (int other : nodes[node].links) {
+                    if (static_cast<size_t>(other) > node && nodes[other].faction == faction) {
+                        callback(nodes[node].position, nodes[other].position);
+                    }
+                }
+            }
+        }
+
+    private:
+        struct Node {
+            EntityID id;
+            sf::Vector2f position;
+            Components::Faction faction;
+            int capacity;
+            int drones;                 // Parked at the structure
+            int element;                // Set element of the grid the structure is in
+            std::vector<int> links;     // Nodes within link radius
+        };
+
+        struct Element {
+            int parent;
+            int size;
+            int capacity;               // Summed over the set, valid at the root
+            int drones;                 // Summed over the set, valid at the root
+        };
+
+        // A search from one of the links of a structure that left its grid, see leave()
+        struct Search {
+            int parent;                 // Searches that met are merged, a union-find over the searches
+            std::vector<int> found;     // Nodes reached, the ones from next on are still to be expanded
+            size_t next;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Element> elements;
+        std::unordered_map<EntityID, int> index;
+        std::unordered_map<std::uint64_t, std::vector<int>> buckets;   // Nodes per cell of link radius
+        std::vector<Search> searches;
+        std::vector<int> searchOf;      // Per node, the search that reached it, -1 outside leave()
+
+        int newElement(int capacity, int drones) {
+            elements.push_back(Element{static_cast<int>(elements.size()), 1, capacity, drones});
+            return static_cast<int>(elements.size()) - 1;
+        }
+
+        int find(int element) {
+            while (elements[element].parent != element) {
+                elements[element].parent = elements[elements[element].parent].parent;
+                element = elements[element].parent;
+            }
+            return element;
+        }
+
+        void unite(int first, int second) {
+            first = find(first);
+            second = find(second);
+            if (first == second) {
+                return;
+            }
+            if (elements[first].size < elements[second].size) {
+                std::swap(first, second);
+            }
+            elements[second].parent = first;
+            elements[first].size += elements[second].size;
+            elements[first].capacity += elements[second].capacity;
+            elements[first].drones += elements[second].drones;
+        }
+
+        void join(int node, Components::Faction faction) {
+            nodes[node].faction = faction;
+            if (faction == Components::Faction::NEUTRAL) {
+                return;
+            }
+            for (int other : nodes[node].links) {
+                if (nodes[other].faction == faction) {
+                    unite(nodes[node].element, nodes[other].element);
+                }
+            }
+        }
+
+        // Take a structure out of its grid, it ends up neutral and alone
+        void leave(int node) {
+            Components::Faction faction = nodes[node].faction;
+            nodes[node].faction = Components::Faction::NEUTRAL;
+            if (faction == Components::Faction::NEUTRAL) {
+                return;
+            }
+
+            int linked = 0;
+            for (int other : nodes[node].links) {
+                linked += nodes[other].faction == faction;
+            }
+            int root = find(nodes[node].element);
+            elements[root].capacity -= nodes[node].capacity;
+            elements[root].drones -= nodes[node].drones;
+            elements[root].size--;
+            nodes[node].element = newElement(nodes[node].capacity, nodes[node].drones);
+            if (linked < 2) {
+                return;
+            }
+
+            // The structure may have held the grid together. A search starts from every linked structure, the
+            // searches expand a node each in turn and merge when they meet, until at most one is still going.
+            // A search that ran out found a whole piece, the one still going is in the largest piece, which keeps
+            // the old set. Only the smaller pieces are visited.
+            searches.clear();
+            for (int other : nodes[node].links) {
+                if (nodes[other].faction == faction && searchOf[other] < 0) {
+                    searchOf[other] = static_cast<int>(searches.size());
+                    searches.push_back(Search{static_cast<int>(searches.size()), {other}, 0});
+                }
+            }
+            int going = findGoing(-1);
+            while (going >= 0 && findGoing(going) >= 0) {
+                for (size_t search = 0; search < searches.size(); ++search) {
+                    if (searches[search].next == searches[search].found.size()) {
+                        continue;
+                    }
+                    int current = searches[search].found[searches[search].next++];
+                    for (int other : nodes[current].links) {
+                        if (nodes[other].faction != faction) {
+                            continue;
+                        }
+                        if (searchOf[other] < 0) {
+                            searchOf[other] = static_cast<int>(search);
+                            searches[search].found.push_back(other);
+                        } else {
+                            int first = findSearch(static_cast<int>(search));
+                            int second = findSearch(searchOf[other]);
+                            searches[std::max(first, second)].parent = std::min(first, second);
+                        }
+                    }
+                }
+                going = findGoing(-1);
+            }
+
+            // Every piece but the one keeping the set moves to an element of its own
+            int kept = going >= 0 ? going : findSearch(0);
+            for (size_t search = 0; search < searches.size(); ++search) {
+                int piece = findSearch(static_cast<int>(search));
+                if (piece != kept && static_cast<size_t>(piece) == search) {
+                    int element = newElement(0, 0);
+                    elements[element].size = 0;
+                    for (size_t member = search; member < searches.size(); ++member) {
+                        if (findSearch(static_cast<int>(member)) != piece) {
+                            continue;
+                        }
+                        for (int moved : searches[member].found) {
+                            nodes[moved].element = element;
+                            elements[element].size++;
+                            elements[element].capacity += nodes[moved].capacity;
+                            elements[element].drones += nodes[moved].drones;
+                        }
+                    }
+                    elements[root].size -= elements[element].size;
+                    elements[root].capacity -= elements[element].capacity;
+                    elements[root].drones -= elements[element].drones;
+                }
+            }
+            for (auto& search : searches) {
+                for (int reached : search.found) {
+                    searchOf[reached] = -1;
+                }
+            }
+        }
+
+        int findSearch(int search) {
+            while (searches[search].parent != search) {
+                search = searches[search].parent;
+            }
+            return search;
+        }
+
+        // A merged search with nodes left to expand other than the given one, -1 when there is none
+        int findGoing(int except) {
+            for (size_t search = 0; search < searches.size(); ++search) {
+                if (searches[search].next < searches[search].found.size()) {
+                    int piece = findSearch(static_cast<int>(search));
+                    if (piece != except) {
+                        return piece;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        // Drop the abandoned elements, every live structure gets a fresh one and the grids are joined again
+        void compact() {
+            elements.clear();
+            for (auto& node : nodes) {
+                node.element = newElement(node.capacity, node.drones);
+            }
+            for (size_t node = 0; node < nodes.size(); ++node) {
+                if (nodes[node].faction == Components::Faction::NEUTRAL) {
+                    continue;
+                }
+                for (int other : nodes[node].links) {
+                    if (nodes[other].faction == nodes[node].faction) {
+                        unite(nodes[node].element, nodes[other].element);
+                    }
+                }
+            }
+        }
+
+        std::pair<int, int> getBucket(sf::Vector2f position) const {
+            return {static_cast<int>(std::floor(position.x / Config::POWER_LINK_RADIUS)), static_cast<int>(std::floor(position.y / Config::POWER_LINK_RADIUS))};
+        }
+
+        static std::uint64_t getKey(int column, int row) {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) | static_cast<std::uint32_t>(column);
+        }
+    };
+}
+
+#endif // POWER_GRID_HPP
@@ -0,0 +1,418 @@
+#ifndef REGION_TREE_HPP
+#define REGION_TREE_HPP
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Per-faction strength by map region: garrisoned drones, drones in flight, shield and energy.
+    // A quadtree over cells of REGION_CELL_SIZE, stored level by level, every node holding the totals of its cells.
+    // A change recomputes its cell and the nodes above it from their four children, so float totals do not drift.
+    // Queries add up the nodes that lie wholly inside the area and only descend into the ones its border crosses.
+    // Structures in a border cell are tested one by one, drones in flight are counted by the cell they are over
+    // and count when the cell center is inside.
+    // Shields regenerate up to their maximum, a regenerating shield is summed as base + rate * time and each node
+    // keeps the earliest time one of its shields fills up. Queries first move the shields that filled up to the full totals.
+    class RegionTree {
+    public:
+        using Cell = std::uint16_t;
+        using FactionMask = std::uint32_t;
+
+        static constexpr FactionMask ALL_FACTIONS = (FactionMask(1) << Components::FACTION_COUNT) - 1;
+
+        static FactionMask getMask(Components::Faction faction) {
+            return FactionMask(1) << static_cast<unsigned int>(faction);
+        }
+
+        // Every player but the faction, neutral structures left out
+        static FactionMask getOpponents(Components::Faction faction) {
+            return ALL_FACTIONS & ~getMask(faction) & ~getMask(Components::Faction::NEUTRAL);
+        }
+
+        struct Strength {
+            unsigned int garrisonedDrones = 0;
+            unsigned int inFlightDrones = 0;
+            unsigned int energy = 0;
+            float shield = 0.f;
+
+            unsigned int getDrones() const {
+                return garrisonedDrones + inFlightDrones;
+            }
+        };
+
+        RegionTree() {
+            columns = static_cast<int>(std::ceil(Config::MAP_WIDTH / Config::REGION_CELL_SIZE));
+            rows = static_cast<int>(std::ceil(Config::MAP_HEIGHT / Config::REGION_CELL_SIZE));
+            depth = 0;
+            while ((1 << depth) < std::max(columns, rows)) {
+                depth++;
+            }
+            size_t count = 0;
+            for (int level = 0; level <= depth; ++level) {
+                levelOffsets.push_back(count);
+                count += static_cast<size_t>(1) << (2 * level);
+            }
+            nodes.resize(count);
+            cellStructures.resize(static_cast<size_t>(1) << (2 * depth));
+            cellDrones.assign(cellStructures.size() * Components::FACTION_COUNT, 0);
+        }
+
+        // Drones off the map belong to the nearest border cell
+        Cell getCell(sf::Vector2f position) const {
+            int column = std::clamp(static_cast<int>(std::floor(position.x / Config::REGION_CELL_SIZE)), 0, columns - 1);
+            int row = std::clamp(static_cast<int>(std::floor(position.y / Config::REGION_CELL_SIZE)), 0, rows - 1);
+            return static_cast<Cell>((row << depth) | column);
+        }
+
+        // Add a structure or bring it up to date, shields as (base, base time) the way ShieldComponent keeps them
+        void setStructure(EntityID id, sf::Vector2f position, Components::Faction faction, unsigned int garrison, unsigned int energy,
+                          float shieldBase, double shieldTime, float maxShield, float regenRate) {
+            auto it = structures.find(id);
+            if (it == structures.end()) {
+                it = structures.emplace(id, Structure{}).first;
+                it->second.cell = getCell(position);
+                it->second.faction = faction;
+                cellStructures[it->second.cell].push_back(id);
+            }
+            Structure& structure = it->second;
+            Components::Faction previous = structure.faction;
+            structure.position = position;
+            structure.faction = faction;
+            structure.garrison = garrison;
+            structure.energy = energy;
+            structure.maxShield = maxShield;
+            structure.regenRate = regenRate;
+            setShieldValues(structure, shieldBase, shieldTime);
+            refresh(structure.cell, previous);
+            if (faction != previous) {
+                refresh(structure.cell, faction);
+            }
+        }
+
+        void removeStructure(EntityID id) {
+            auto it = structures.find(id);
+            if (it == structures.end()) {
+                return;
+            }
+            Cell cell = it->second.cell;
+            Components::Faction faction = it->second.faction;
+            auto& list = cellStructures[cell];
+            list.erase(std::remove(list.begin(), list.end(), id), list.end());
+            structures.erase(it);
+            refresh(cell, faction);
+        }
+
+        void setFaction(EntityID id, Components::Faction faction) {
+            auto it = structures.find(id);
+            if (it == structures.end() || it->second.faction == faction) {
+                return;
+            }
+            Components::Faction previous = it->second.faction;
+            it->second.faction = faction;
+            refresh(it->second.cell, previous);
+            refresh(it->second.cell, faction);
+        }
+
+        void setGarrison(EntityID id, unsigned int garrison) {
+            auto it = structures.find(id);
+            if (it != structures.end() && it->second.garrison != garrison) {
+                it->second.garrison = garrison;
+                refresh(it->second.cell, it->second.faction);
+            }
+        }
+
+        void setShield(EntityID id, float shieldBase, double shieldTime) {
+            auto it = structures.find(id);
+            if (it != structures.end()) {
+                setShieldValues(it->second, shieldBase, shieldTime);
+                refresh(it->second.cell, it->second.faction);
+            }
+        }
+
+        void addDrone(Components::Faction faction, Cell cell) {
+            cellDrones[getDroneIndex(cell, faction)]++;
+            refresh(cell, faction);
+        }
+
+        void removeDrone(Components::Faction faction, Cell cell) {
+            cellDrones[getDroneIndex(cell, faction)]--;
+            refresh(cell, faction);
+        }
+
+        void moveDrone(Components::Faction faction, Cell from, Cell to) {
+            if (from != to) {
+                addDrone(faction, to);
+                removeDrone(faction, from);
+            }
+        }
+
+        // Strength of the factions in the mask within the area at a time
+        Strength query(const sf::FloatRect& area, FactionMask factions, double time) {
+            float right = area.left + area.width;
+            float bottom = area.top + area.height;
+            return search(time, factions,
+                [&](const sf::FloatRect& bounds) {
+                    return bounds.left >= area.left && bounds.top >= area.top && bounds.left + bounds.width <= right && bounds.top + bounds.height <= bottom;
+                },
+                [&](const sf::FloatRect& bounds) {
+                    return bounds.left + bounds.width < area.left || bounds.top + bounds.height < area.top || bounds.left >= right || bounds.top >= bottom;
+                },
+                [&](sf::Vector2f point) {
+                    return point.x >= area.left && point.y >= area.top && point.x < right && point.y < bottom;
+                });
+        }
+
+        Strength query(sf::Vector2f center, float radius, FactionMask factions, double time) {
+            float radiusSquared = radius * radius;
+            return search(time, factions,
+                [&](const sf::FloatRect& bounds) {
+                    float dx = std::max(center.x - bounds.left, bounds.left + bounds.width - center.x);
+                    float dy = std::max(center.y - bounds.top, bounds.top + bounds.height - center.y);
+                    return dx * dx + dy * dy <= radiusSquared;
+                },
+                [&](const sf::FloatRect& bounds) {
+                    float dx = center.x - std::clamp(center.x, bounds.left, bounds.left + bounds.width);
+                    float dy = center.y - std::clamp(center.y, bounds.top, bounds.top + bounds.height);
+                    return dx * dx + dy * dy > radiusSquared;
+                },
+                [&](sf::Vector2f point) {
+                    float dx = point.x - center.x;
+                    float dy = point.y - center.y;
+                    return dx * dx + dy * dy <= radiusSquared;
+                });
+        }
+
+        size_t getStructureCount() const {
+            return structures.size();
+        }
+
+        void clear() {
+            structures.clear();
+            for (auto& list : cellStructures) {
+                list.clear();
+            }
+            std::fill(cellDrones.begin(), cellDrones.end(), 0);
+            std::fill(nodes.begin(), nodes.end(), Node{});
+        }
+
+    private:
+        static constexpr double NEVER = std::numeric_limits<double>::infinity();
+        static constexpr float OFF_MAP = 1e9f;
+
+        // Totals of one faction, regenerating shields as shieldBase + shieldRate * time.
+        // The line is extrapolated back to time 0, in double so it does not cancel out late in a match.
+        struct Totals {
+            std::int32_t garrisonedDrones = 0;
+            std::int32_t inFlightDrones = 0;
+            std::int32_t energy = 0;
+            double shieldBase = 0.0;
+            double shieldRate = 0.0;
+            float shieldFull = 0.f;
+
+            Totals& operator+=(const Totals& other) {
+                garrisonedDrones += other.garrisonedDrones;
+                inFlightDrones += other.inFlightDrones;
+                energy += other.energy;
+                shieldBase += other.shieldBase;
+                shieldRate += other.shieldRate;
+                shieldFull += other.shieldFull;
+                return *this;
+            }
+        };
+
+        struct Node {
+            std::array<Totals, Components::FACTION_COUNT> totals{};
+            double nextFull = NEVER;    // Earliest time a regenerating shield below fills up
+        };
+
+        struct Structure {
+            sf::Vector2f position;
+            Cell cell = 0;
+            Components::Faction faction = Components::Faction::NEUTRAL;
+            unsigned int garrison = 0;
+            unsigned int energy = 0;
+            float shieldBase = 0.f;
+            double shieldTime = 0.0;
+            float maxShield = 0.f;
+            float regenRate = 0.f;
+            double fullTime = NEVER;    // When the shield reaches its maximum, NEVER once it has
+
+            float getShield(double time) const {
+                return std::min(maxShield, shieldBase + regenRate * static_cast<float>(std::max(time - shieldTime, 0.0)));
+            }
+        };
+
+        int columns = 1;
+        int rows = 1;
+        int depth = 0;                              // Levels below the root, cells are the nodes of the last one
+        std::vector<size_t> levelOffsets;
+        std::vector<Node> nodes;
+        std::unordered_map<EntityID, Structure> structures;
+        std::vector<std::vector<EntityID>> cellStructures;
+        std::vector<std::int32_t> cellDrones;       // Per cell, then per faction
+
+        size_t getDroneIndex(Cell cell, Components::Faction faction) const {
+            return static_cast<size_t>(cell) * Components::FACTION_COUNT + static_cast<size_t>(faction);
+        }
+
+        Node& getNode(int level, size_t column, size_t row) {
+            return nodes[levelOffsets[level] + (row << level) + column];
+        }
+
+        static void setShieldValues(Structure& structure, float shieldBase, double shieldTime) {
+            structure.shieldBase = shieldBase;
+            structure.shieldTime = shieldTime;
+            structure.fullTime = NEVER;
+            if (structure.regenRate > 0.f && shieldBase < structure.maxShield) {
+                structure.fullTime = shieldTime + (structure.maxShield - shieldBase) / structure.regenRate;
+            }
+        }
+
+        // Recompute a cell's totals for a faction and the nodes above it
+        void refresh(Cell cell, Components::Faction faction) {
+            size_t column = cell & ((1u << depth) - 1);
+            size_t row = cell >> depth;
+            size_t index = static_cast<size_t>(faction);
+
+            Node& leaf = getNode(depth, column, row);
+            Totals totals;
+            totals.inFlightDrones = cellDrones[getDroneIndex(cell, faction)];
+            leaf.nextFull = NEVER;
+            for (EntityID id : cellStructures[cell]) {
+                const Structure& structure = structures.at(id);
+                leaf.nextFull = std::min(leaf.nextFull, structure.fullTime);
+                if (structure.faction != faction) {
+                    continue;
+                }
+                totals.garrisonedDrones += structure.garrison;
+                totals.energy += structure.energy;
+                if (structure.fullTime == NEVER) {
+                    totals.shieldFull += std::min(structure.maxShield, structure.shieldBase);
+                } else {
+                    totals.shieldBase += structure.shieldBase - static_cast<double>(structure.regenRate) * structure.shieldTime;
+                    totals.shieldRate += structure.regenRate;
+                }
+            }
+            leaf.totals[index] = totals;
+
+            for (int level = depth - 1; level >= 0; --level) {
+                column /= 2;
+                row /= 2;
+                Node& node = getNode(level, column, row);
+                node.totals[index] = Totals{};
+                node.nextFull = NEVER;
+                for (size_t child = 0; child < 4; ++child) {
+                    const Node& below = getNode(level + 1, column * 2 + child % 2, row * 2 + child / 2);
+                    node.totals[index] += below.totals[index];
+                    node.nextFull = std::min(node.nextFull, below.nextFull);
+                }
+            }
+        }
+
+        // Count the shields that filled up by the time as full, in the cells that hold them
+        void settle(double time, int level, size_t column, size_t row) {
+            if (getNode(level, column, row).nextFull > time) {
+                return;
+            }
+            if (level == depth) {
+                auto cell = static_cast<Cell>((row << depth) | column);
+                for (EntityID id : cellStructures[cell]) {
+                    Structure& structure = structures.at(id);
+                    if (structure.fullTime <= time) {
+                        structure.shieldBase = structure.maxShield;
+                        structure.shieldTime = structure.fullTime;
+                        structure.fullTime = NEVER;
+                        refresh(cell, structure.faction);
+                    }
+                }
+                return;
+            }
+            for (size_t child = 0; child < 4; ++child) {
+                settle(time, level + 1, column * 2 + child % 2, row * 2 + child / 2);
+            }
+        }
+
+        // Area a node covers, the border cells stretch out to hold what lies off the map
+        sf::FloatRect getBounds(int level, size_t column, size_t row) const {
+            float size = Config::REGION_CELL_SIZE * static_cast<float>(1 << (depth - level));
+            size_t span = static_cast<size_t>(1) << (depth - level);
+            float left = column == 0 ? -OFF_MAP : column * size;
+            float top = row == 0 ? -OFF_MAP : row * size;
+            float right = column * span < static_cast<size_t>(columns) && static_cast<size_t>(columns) <= (column + 1) * span ? OFF_MAP : (column + 1) * size;
+            float bottom = row * span < static_cast<size_t>(rows) && static_cast<size_t>(rows) <= (row + 1) * span ? OFF_MAP : (row + 1) * size;
+            return sf::FloatRect(left, top, right - left, bottom - top);
+        }
+
+        static void add(Strength& strength, const Totals& totals, double time) {
+            strength.garrisonedDrones += static_cast<unsigned int>(totals.garrisonedDrones);
+            strength.inFlightDrones += static_cast<unsigned int>(totals.inFlightDrones);
+            strength.energy += static_cast<unsigned int>(totals.energy);
+            strength.shield += static_cast<float>(totals.shieldBase + totals.shieldRate * time) + totals.shieldFull;
+        }
+
+        template<typename Inside, typename Outside, typename Contains>
+        Strength search(double time, FactionMask factions, Inside inside, Outside outside, Contains contains) {
+            settle(time, 0, 0, 0);
+            Strength strength;
+            visit(0, 0, 0, time, factions, inside, outside, contains, strength);
+            return strength;
+        }
+
+        template<typename Inside, typename Outside, typename Contains>
+        void visit(int level, size_t column, size_t row, double time, FactionMask factions,
+                   Inside& inside, Outside& outside, Contains& contains, Strength& strength) {
+            float size = Config::REGION_CELL_SIZE * static_cast<float>(1 << (depth - level));
+            float left = column * size;
+            float top = row * size;
+            if (outside(getBounds(level, column, row))) {
+                return;
+            }
+            Node& node = getNode(level, column, row);
+            if (inside(getBounds(level, column, row))) {
+                for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                    if (factions & (FactionMask(1) << faction)) {
+                        add(strength, node.totals[faction], time);
+                    }
+                }
+                return;
+            }
+            if (level < depth) {
+                for (size_t child = 0; child < 4; ++child) {
+                    visit(level + 1, column * 2 + child % 2, row * 2 + child / 2, time, factions, inside, outside, contains, strength);
+                }
+                return;
+            }
+
+            // A cell on the border of the area
+            auto cell = static_cast<Cell>((row << depth) | column);
+            for (EntityID id : cellStructures[cell]) {
+                const Structure& structure = structures.at(id);
+                if ((factions & getMask(structure.faction)) && contains(structure.position)) {
+                    strength.garrisonedDrones += structure.garrison;
+                    strength.energy += structure.energy;
+                    strength.shield += structure.getShield(time);
+                }
+            }
+            if (contains({left + size / 2.f, top + size / 2.f})) {
+                for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                    if (factions & (FactionMask(1) << faction)) {
+                        strength.inFlightDrones += static_cast<unsigned int>(cellDrones[getDroneIndex(cell, static_cast<Components::Faction>(faction))]);
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif // REGION_TREE_HPP
@@ -0,0 +1,438 @@
+#ifndef REWIND_BUFFER_HPP
+#define REWIND_BUFFER_HPP
+
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <SFML/Graphics.hpp>
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/Builder.hpp"
+#include "Components/DroneTransferComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
+#include "Components/LaunchComponent.hpp"
+#include "Components/AIComponent.hpp"
+#include "Utils/Random.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // History of the last minutes of a match, for scrubbing back.
+    // Every few seconds a keyframe captures the gameplay state (structures and drones in flight),
+    // the ticks in between only store what changed: structure fields, launched and landed drones.
+    // Segments (a keyframe and its ticks) are kept in a bounded ring, the oldest one is dropped once it leaves the window.
+    class RewindBuffer {
+    public:
+        // The timer wheel is cleared by a seek, these are the timers to schedule again
+        struct RestoredTimers {
+            std::vector<std::pair<EntityID, double>> production; // Factory and the time its next drone is due
+            double aiDecision = -1.0;
+        };
+
+        // Record the world after a simulation step
+        void record(GameEntityManager& entityManager) {
+            if (!listening) {
+                entityManager.setDroneJournal(true);
+                listening = true;
+            }
+
+            double now = entityManager.getTime();
+            if (branched) {
+                // Continuing from a seek: the recorded future is gone, start over from here
+                truncate(now);
+                branched = false;
+                startSegment(entityManager);
+                return;
+            }
+            if (segments.empty() || now - segments.back().time >= Config::REWIND_KEYFRAME_INTERVAL_SEC || entityManager.getGarissons().size() != baseline.size()) {
+                startSegment(entityManager);
+                evict(now);
+                return;
+            }
+
+            Segment& segment = segments.back();
+            entityManager.drainDroneJournal(spawnedScratch, removedScratch);
+
+            // A drone can launch and land within the same tick, it is left out entirely
+            transientScratch.clear();
+            for (EntityID id : spawnedScratch) {
+                if (entityManager.hasEntity(id)) {
+                    segment.spawned.push_back(captureDrone(entityManager, id));
+                } else {
+                    transientScratch.insert(id);
+                }
+            }
+            for (EntityID id : removedScratch) {
+                if (transientScratch.empty() || transientScratch.count(id) == 0) {
+                    segment.removed.push_back(id);
+                }
+            }
+
+            const auto& structures = entityManager.getGarissons();
+            for (size_t i = 0; i < structures.size(); ++i) {
+                StructureState state = captureStructure(entityManager, structures[i]);
+                if (!(state == baseline[i])) {
+                    segment.structureChanges.push_back(state);
+                    baseline[i] = state;
+                }
+            }
+
+            TickRecord tick = captureTick(entityManager);
+            tick.structureEnd = static_cast<std::uint32_t>(segment.structureChanges.size());
+            tick.spawnedEnd = static_cast<std::uint32_t>(segment.spawned.size());
+            tick.removedEnd = static_cast<std::uint32_t>(segment.removed.size());
+            segment.ticks.push_back(tick);
+        }
+
+        // Restore the world as it was at the given time, clamped to the recorded range.
+        // The nearest keyframe before the time is restored and the recorded ticks are replayed on top of it.
+        RestoredTimers seek(GameEntityManager& entityManager, double time) {
+            sf::Clock clock;
+            RestoredTimers restored;
+            if (segments.empty()) {
+                return restored;
+            }
+            time = std::clamp(time, getStartTime(), getEndTime());
+
+            auto segmentIt = std::upper_bound(segments.begin(), segments.end(), time, [](double t, const Segment& segment) {
+                return t < segment.time;
+            });
+            const Segment& segment = *std::prev(segmentIt);
+
+            size_t tickCount = 0;
+            while (tickCount < segment.ticks.size() && segment.ticks[tickCount].time <= time) {
+                tickCount++;
+            }
+
+            // Drones that land before the target time are never created
+            std::unordered_set<EntityID> landed;
+            size_t removedEnd = tickCount > 0 ? segment.ticks[tickCount - 1].removedEnd : 0;
+            landed.insert(segment.removed.begin(), segment.removed.begin() + removedEnd);
+
+            // Drones are recreated and get new IDs, in the recorded order so arrival ties resolve the same way
+            std::vector<EntityID> drones = entityManager.getDrones();
+            entityManager.removeEntities(drones);
+            entityManager.getArrivals().clear();
+
+            std::unordered_map<EntityID, double> productionDue;
+            for (const auto& state : segment.structures) {
+                applyStructure(entityManager, state, productionDue);
+            }
+            for (const auto& state : segment.drones) {
+                if (landed.count(state.id) == 0) {
+                    restoreDrone(entityManager, state);
+                }
+            }
+
+            TickRecord last = segment.keyframe;
+            size_t structureBegin = 0;
+            size_t spawnedBegin = 0;
+            for (size_t i = 0; i < tickCount; ++i) {
+                const TickRecord& tick = segment.ticks[i];
+                for (size_t j = structureBegin; j < tick.structureEnd; ++j) {
+                    applyStructure(entityManager, segment.structureChanges[j], productionDue);
+                }
+                for (size_t j = spawnedBegin; j < tick.spawnedEnd; ++j) {
+                    if (landed.count(segment.spawned[j].id) == 0) {
+                        restoreDrone(entityManager, segment.spawned[j]);
+                    }
+                }
+                structureBegin = tick.structureEnd;
+                spawnedBegin = tick.spawnedEnd;
+                last = tick;
+            }
+
+            auto* gameState = entityManager.getGameState();
+            gameState->time = last.time;
+            gameState->tick = last.tick;
+            gameState->isGameOver = last.isGameOver;
+            gameState->winner = last.winner;
+            entityManager.getRandom().restore(segment.random, last.randomDraws);
+            entityManager.rebuildAggregates();
+
+            // Old timer IDs would alias the timers scheduled on the cleared wheel
+            entityManager.getTimers().clear(last.time);
+            for (EntityID factoryID : entityManager.getFactories()) {
+                entityManager.getComponent<Components::FactoryComponent>(factoryID)->productionTimerID = 0;
+            }
+            for (EntityID aiEntityID : entityManager.getAIEntities()) {
+                entityManager.getComponent<Components::AIComponent>(aiEntityID)->decisionTimerID = 0;
+            }
+
+            for (auto& [factoryID, due] : productionDue) {
+                if (due >= 0.0) {
+                    restored.production.emplace_back(factoryID, due);
+                }
+            }
+            std::sort(restored.production.begin(), restored.production.end());
+            restored.aiDecision = last.aiDecision;
+
+            // Recording continues from the restored point once the simulation steps again
+            branched = true;
+            lastSeekMs = clock.getElapsedTime().asSeconds() * 1000.f;
+            lastSeekTicks = tickCount;
+            return restored;
+        }
+
+        bool empty() const { return segments.empty(); }
+        double getStartTime() const { return segments.empty() ? 0.0 : segments.front().time; }
+        double getEndTime() const {
+            if (segments.empty()) {
+                return 0.0;
+            }
+            const Segment& segment = segments.back();
+            return segment.ticks.empty() ? segment.time : segment.ticks.back().time;
+        }
+
+        size_t getMemoryUsage() const {
+            size_t bytes = sizeof(*this) + baseline.capacity() * sizeof(StructureState);
+            for (const auto& segment : segments) {
+                bytes += sizeof(Segment);
+                bytes += (segment.structures.capacity() + segment.structureChanges.capacity()) * sizeof(StructureState);
+                bytes += (segment.drones.capacity() + segment.spawned.capacity()) * sizeof(DroneState);
+                bytes += segment.ticks.capacity() * sizeof(TickRecord);
+                bytes += segment.removed.capacity() * sizeof(EntityID);
+            }
+            return bytes;
+        }
+
+        float getBytesPerMinute() const {
+            double duration = std::max(getEndTime() - getStartTime(), 1.0);
+            return static_cast<float>(getMemoryUsage() / duration * 60.0);
+        }
+
+        float getLastSeekMs() const { return lastSeekMs; }
+        size_t getLastSeekTicks() const { return lastSeekTicks; }
+
+    private:
+        struct StructureState {
+            EntityID id = 0;
+            Components::Faction faction = Components::Faction::NEUTRAL;
+            unsigned int garrison = 0;
+            float shieldBase = 0.f;
+            double shieldTime = 0.0;
+            double productionDue = -1.0;   // Negative while the factory does not produce
+            EntityID transferTarget = 0;  // 0 without a drone transfer route
+            Components::Faction transferFaction = Components::Faction::NEUTRAL;
+            EntityID launchTarget = 0;    // 0 without an attack wave leaving
+            Components::Faction launchFaction = Components::Faction::NEUTRAL;
+            unsigned int launchWave = 0;
+            unsigned int launchRemaining = 0;
+            unsigned int launched = 0;
+            double launchStart = 0.0;
+
+            bool operator==(const StructureState& other) const {
+                return id == other.id && faction == other.faction && garrison == other.garrison
+                    && shieldBase == other.shieldBase && shieldTime == other.shieldTime
+                    && productionDue == other.productionDue
+                    && transferTarget == other.transferTarget && transferFaction == other.transferFaction
+                    && launchTarget == other.launchTarget && launchFaction == other.launchFaction
+                    && launchWave == other.launchWave && launchRemaining == other.launchRemaining
+                    && launched == other.launched && launchStart == other.launchStart;
+            }
+        };
+
+        struct DroneState {
+            EntityID id;
+            Components::Faction faction;
+            EntityID origin;
+            EntityID target;
+            sf::Vector2f from;
+            sf::Vector2f to;
+            double launchTime;
+            double waveTime;
+            std::shared_ptr<const Navigation::Route> route;   // As launched, hyperlane routes depend on who owned what
+        };
+
+        struct TickRecord {
+            double time = 0.0;
+            std::uint64_t tick = 0;
+            std::uint32_t structureEnd = 0; // End of this tick's entries in the segment pools
+            std::uint32_t spawnedEnd = 0;
+            std::uint32_t removedEnd = 0;
+            double aiDecision = -1.0;
+            Components::Faction winner = Components::Faction::NEUTRAL;
+            bool isGameOver = false;
+            std::uint64_t randomDraws = 0;  // Draws of the world generator so far, launch spreads draw from it
+        };
+
+        struct Segment {
+            double time = 0.0;
+            TickRecord keyframe;                        // Clock, AI timer and outcome at the keyframe
+            Utils::Random::State random;                // World generator at the keyframe, seeks replay the draws after it
+            std::vector<StructureState> structures;
+            std::vector<DroneState> drones;             // Sorted by ID
+
+            std::vector<TickRecord> ticks;
+            std::vector<StructureState> structureChanges;
+            std::vector<DroneState> spawned;
+            std::vector<EntityID> removed;
+        };
+
+        std::deque<Segment> segments;
+        std::vector<StructureState> baseline; // Last recorded state of every structure, in garisson list order
+        bool listening = false;
+        bool branched = false;
+        float lastSeekMs = 0.f;
+        size_t lastSeekTicks = 0;
+
+        std::vector<EntityID> spawnedScratch;
+        std::vector<EntityID> removedScratch;
+        std::unordered_set<EntityID> transientScratch;
+
+        static StructureState captureStructure(GameEntityManager& entityManager, EntityID id) {
+            Entity& entity = entityManager.getEntity(id);
+            StructureState state;
+            state.id = id;
+            if (auto* faction = entity.getComponent<Components::FactionComponent>()) {
+                state.faction = faction->faction;
+            }
+            if (auto* garisson = entity.getComponent<Components::GarissonComponent>()) {
+                state.garrison = garisson->getDroneCount();
+            }
+            if (auto* shield = entity.getComponent<Components::ShieldComponent>()) {
+                state.shieldBase = shield->baseShield;
+                state.shieldTime = shield->baseTime;
+            }
+            if (auto* factory = entity.getComponent<Components::FactoryComponent>()) {
+                state.productionDue = entityManager.getTimers().getDueTime(factory->productionTimerID);
+            }
+            if (auto* transfer = entity.getComponent<Components::DroneTransferComponent>()) {
+                state.transferTarget = transfer->target;
+                state.transferFaction = transfer->faction;
+            }
+            if (auto* launch = entity.getComponent<Components::LaunchComponent>()) {
+                state.launchTarget = launch->target;
+                state.launchFaction = launch->faction;
+                state.launchWave = launch->waveSize;
+                state.launchRemaining = launch->remaining;
+                state.launched = launch->launched;
+                state.launchStart = launch->startTime;
+            }
+            return state;
+        }
+
+        static DroneState captureDrone(GameEntityManager& entityManager, EntityID id) {
+            Entity& entity = entityManager.getEntity(id);
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            auto* attackOrder = entity.getComponent<Components::AttackOrderComponent>();
+            auto* move = entity.getComponent<Components::MoveComponent>();
+            return DroneState{
+                id,
+                faction ? faction->faction : Components::Faction::NEUTRAL,
+                attackOrder ? attackOrder->origin : 0,
+                attackOrder ? attackOrder->target : 0,
+                move->launchPosition,
+                move->targetPosition,
+                move->launchTime,
+                attackOrder ? attackOrder->waveTime : move->launchTime,
+                move->route
+            };
+        }
+
+        static TickRecord captureTick(GameEntityManager& entityManager) {
+            TickRecord tick;
+            auto* gameState = entityManager.getGameState();
+            tick.time = gameState->time;
+            tick.tick = gameState->tick;
+            // Every AI runs on the same timer
+            auto& aiEntities = entityManager.getAIEntities();
+            if (!aiEntities.empty()) {
+                auto* ai = entityManager.getComponent<Components::AIComponent>(aiEntities.front());
+                tick.aiDecision = entityManager.getTimers().getDueTime(ai->decisionTimerID);
+            }
+            tick.winner = gameState->winner;
+            tick.isGameOver = gameState->isGameOver;
+            tick.randomDraws = entityManager.getRandom().getDraws();
+            return tick;
+        }
+
+        static void applyStructure(GameEntityManager& entityManager, const StructureState& state, std::unordered_map<EntityID, double>& productionDue) {
+            Entity& entity = entityManager.getEntity(state.id);
+            if (auto* faction = entity.getComponent<Components::FactionComponent>()) {
+                faction->faction = state.faction;
+            }
+            if (auto* garisson = entity.getComponent<Components::GarissonComponent>()) {
+                garisson->setDroneCount(state.garrison);
+            }
+            if (auto* shield = entity.getComponent<Components::ShieldComponent>()) {
+                shield->setShield(state.shieldBase, state.shieldTime);
+            }
+            if (state.transferTarget != 0) {
+                entityManager.addComponent(state.id, Components::DroneTransferComponent{state.id, state.transferTarget, state.transferFaction});
+            } else if (entity.hasComponent<Components::DroneTransferComponent>()) {
+                entityManager.removeComponent<Components::DroneTransferComponent>(state.id);
+            }
+            if (state.launchTarget != 0) {
+                Components::LaunchComponent launch{state.launchTarget, state.launchFaction, state.launchWave, state.launchStart};
+                launch.remaining = state.launchRemaining;
+                launch.launched = state.launched;
+                entityManager.addComponent(state.id, launch);
+            } else if (entity.hasComponent<Components::LaunchComponent>()) {
+                entityManager.removeComponent<Components::LaunchComponent>(state.id);
+            }
+            if (entity.hasComponent<Components::FactoryComponent>()) {
+                productionDue[state.id] = state.productionDue;
+            }
+        }
+
+        static void restoreDrone(GameEntityManager& entityManager, const DroneState& state) {
+            Game::launchDroneOnRoute(entityManager, state.faction, state.origin, state.target, state.from, state.to, state.launchTime, state.waveTime, state.route);
+        }
+
+        void startSegment(GameEntityManager& entityManager) {
+            Segment segment;
+            segment.time = entityManager.getTime();
+            segment.keyframe = captureTick(entityManager);
+            segment.random = entityManager.getRandom().getState();
+
+            baseline.clear();
+            for (EntityID id : entityManager.getGarissons()) {
+                baseline.push_back(captureStructure(entityManager, id));
+            }
+            segment.structures = baseline;
+
+            for (EntityID id : entityManager.getDrones()) {
+                segment.drones.push_back(captureDrone(entityManager, id));
+            }
+            std::sort(segment.drones.begin(), segment.drones.end(), [](const DroneState& a, const DroneState& b) {
+                return a.id < b.id;
+            });
+
+            // The keyframe already holds every drone
+            entityManager.drainDroneJournal(spawnedScratch, removedScratch);
+            segments.push_back(std::move(segment));
+        }
+
+        // Drop the oldest segments once the next one alone covers the history window
+        void evict(double now) {
+            while (segments.size() > 1 && segments[1].time <= now - Config::REWIND_HISTORY_SEC) {
+                segments.pop_front();
+            }
+        }
+
+        // Forget everything recorded after the given time
+        void truncate(double time) {
+            while (!segments.empty() && segments.back().time > time) {
+                segments.pop_back();
+            }
+            if (segments.empty()) {
+                return;
+            }
+            Segment& segment = segments.back();
+            while (!segment.ticks.empty() && segment.ticks.back().time > time) {
+                segment.ticks.pop_back();
+            }
+            TickRecord end = segment.ticks.empty() ? TickRecord{} : segment.ticks.back();
+            segment.structureChanges.resize(end.structureEnd);
+            segment.spawned.resize(end.spawnedEnd);
+            segment.removed.resize(end.removedEnd);
+        }
+    };
+}
+
+#endif // REWIND_BUFFER_HPP
@@ -4,6 +4,7 @@
 #include "TGUI/Backend/SFML-Graphics.hpp"
 
 #include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
 #include "Resources/ResourceManager.hpp"
 #include "Config.hpp"
 
@@ -20,7 +21,6 @@
 #include "Components/TagComponent.hpp"
 #include "Components/HoverComponent.hpp"
 #include "Components/GameStateComponent.hpp"
-#include "Components/AIComponent.hpp"
 
 #include "Systems/MovementSystem.hpp"
 #include "Systems/RenderSystem.hpp"
@@ -28,19 +28,9 @@
 #include "Systems/InputSelectionSystem.hpp"
 #include "Systems/InputHoverSystem.hpp"
 #include "Systems/HudSystem.hpp"
-#include "Systems/ProductionSystem.hpp"
-#include "Systems/CombatSystem.hpp"
-#include "Systems/ShieldSystem.hpp"
-#include "Systems/AI/AISystem.hpp"
-#include "Systems/GameStateSystem.hpp"
-#include "Systems/DroneTransferSystem.hpp"
+#include "Systems/ProfilerOverlaySystem.hpp"
 
-#include "Game/Builder.hpp"
-#include "Game/MapGenerator.hpp"
-
-#include "Utils/Random.hpp"
-
-Scene::Scene(sf::RenderWindow& window) : windowRef(window)
+Scene::Scene(sf::RenderWindow& window, std::uint32_t seed, unsigned int playerCount, bool hyperlanes) : simulation(seed, playerCount, hyperlanes), entityManager(simulation.getEntityManager()), windowRef(window)
 {
     log_info << "Creating Scene";
 
@@ -72,15 +62,7 @@ Scene::Scene(sf::RenderWindow& window) : windowRef(window)
     //     }
     // );
 
-    // Create Game State Entity
-    EntityID gameStateID = entityManager.createEntity();
-    entityManager.addComponent(gameStateID, Components::GameStateComponent{2});
-
-    EntityID enemyAI = entityManager.createEntity();
-    entityManager.addComponent(enemyAI, Components::AIComponent{});
-
-    // Generate Map
-    Game::GenerateRandomMap(entityManager, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, 30, 100);
+    log_info << "Match seed " << seed;
 }
 
 Scene::~Scene()
@@ -92,16 +74,26 @@ Scene::~Scene()
 
 void Scene::update(float dt)
 {
-    Systems::InputHoverSystem(entityManager, windowRef);
-    Systems::HudSystem(entityManager, *gui);
-    Systems::ProductionSystem(entityManager, dt);
-    Systems::DroneTransferSystem(entityManager, dt);
-    Systems::MovementSystem(entityManager, dt);
-    Systems::ShieldSystem(entityManager, dt);
-    Systems::CombatSystem(entityManager, dt);
-    Systems::LabelUpdateSystem(entityManager, dt);
-    Systems::AI::AISystem(entityManager, dt);
-    Systems::GameStateSystem(entityManager, dt);
+    Utils::ProfileZone updateZone("Update");
+    {
+        Utils::ProfileZone zone("Simulation");
+        simulationClock.advance(dt, [this](float stepDt) { simulation.step(stepDt); });
+    }
+
+    // Labels and HUD are cosmetic, refresh them less often while the simulation is behind
+    {
+        Utils::ProfileZone zone("Hover");
+        Systems::InputHoverSystem(entityManager, windowRef);
+    }
+    if (simulationClock.shouldRender()) {
+        {
+            Utils::ProfileZone zone("HUD");
+            Systems::HudSystem(entityManager, *gui, simulationClock, simulation);
+        }
+        Utils::ProfileZone zone("Labels");
+        Systems::LabelUpdateSystem(entityManager, dt);
+    }
+    Systems::ProfilerOverlaySystem(entityManager, *gui);
 
     // Wrap Camera Position
     cameraPosition.x = fmod(cameraPosition.x + Config::MAP_WIDTH, Config::MAP_WIDTH);
@@ -111,16 +103,53 @@ void Scene::update(float dt)
     this->windowRef.setView(camera);
 }
 
+Game::Simulation& Scene::getSimulation()
+{
+    return simulation;
+}
+
+bool Scene::shouldRender() const
+{
+    return simulationClock.shouldRender();
+}
+
 void Scene::render()
 {
-    Systems::RenderSystem(entityManager, windowRef);
-    gui->draw();
+    Utils::ProfileZone renderZone("Render");
+    {
+        Utils::ProfileZone zone("Movement");
+        Systems::MovementSystem(entityManager, camera);
+    }
+    {
+        Utils::ProfileZone zone("Draw");
+        Systems::RenderSystem(entityManager, windowRef);
+    }
+    {
+        Utils::ProfileZone zone("GUI");
+        gui->draw();
+    }
 }
 
 void Scene::handleInput(sf::Event &event)
 {
     gui->handleEvent(event);
-    Systems::InputSelectionSystem(event, entityManager, windowRef);
+    Systems::InputSelectionSystem(event, entityManager, windowRef, simulation.getCommandQueue());
+
+    // Simulation speed: Space pauses, +/- change the time scale, Left/Right scrub through the recorded history.
+    // F3 shows the frame profiler
+    if (event.type == sf::Event::KeyPressed) {
+        switch (event.key.code) {
+            case sf::Keyboard::F3: Utils::Profiler::getInstance().setEnabled(!Utils::Profiler::getInstance().isEnabled()); break;
+            case sf::Keyboard::Left: simulation.seek(entityManager.getTime() - Config::REWIND_SEEK_STEP_SEC); break;
+            case sf::Keyboard::Right: simulation.seek(entityManager.getTime() + Config::REWIND_SEEK_STEP_SEC); break;
+            case sf::Keyboard::Space: simulationClock.togglePause(); break;
+            case sf::Keyboard::Add:
+            case sf::Keyboard::Equal: simulationClock.faster(); break;
+            case sf::Keyboard::Subtract:
+            case sf::Keyboard::Hyphen: simulationClock.slower(); break;
+            default: break;
+        }
+    }
 
     // Handle Camera Movement
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) cameraPosition.y -= cameraSpeed * 0.16f;
@@ -4,14 +4,19 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <memory>
+#include <cstdint>
 
 #include "TGUI/TGUI.hpp"
 #include "TGUI/Backend/SFML-Graphics.hpp"
 #include "Game/GameEntityManager.hpp"
+#include "Game/SimulationClock.hpp"
+#include "Game/Simulation.hpp"
 
 class Scene{
 private:
-    Game::GameEntityManager entityManager;
+    Game::Simulation simulation;
+    Game::GameEntityManager& entityManager;
+    Game::SimulationClock simulationClock;
     std::unique_ptr<tgui::Gui> gui;
     sf::RenderWindow& windowRef;
     
@@ -21,11 +26,13 @@ private:
     float cameraSpeed = 200.f;
 
 public:
-    Scene(sf::RenderWindow& window);
+    Scene(sf::RenderWindow& window, std::uint32_t seed, unsigned int playerCount = Config::DEFAULT_PLAYER_COUNT, bool hyperlanes = false);
     ~Scene();   
     void update(float dt);
     void render();
+    bool shouldRender() const;
     void handleInput(sf::Event& event);
+    Game::Simulation& getSimulation();
 };
 
 #endif // SCENE_HPP
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "Simulation.hpp"
+
+#include <cstdio>
+#include <algorithm>
+
+#include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
+#include "Config.hpp"
+
+#include "Components/GameStateComponent.hpp"
+#include "Components/AIComponent.hpp"
+
+#include "Systems/CommandSystem.hpp"
+#include "Systems/ProductionSystem.hpp"
+#include "Systems/CombatSystem.hpp"
+#include "Systems/InterceptionSystem.hpp"
+#include "Systems/AI/AISystem.hpp"
+#include "Systems/GameStateSystem.hpp"
+#include "Systems/DroneTransferSystem.hpp"
+
+#include "Game/Builder.hpp"
+#include "Game/MapGenerator.hpp"
+#include "Game/RewindBuffer.hpp"
+
+namespace Game {
+
+    Simulation::Simulation(std::uint32_t seed, unsigned int playerCount, bool hyperlanes) : rewindBuffer(std::make_unique<RewindBuffer>())
+    {
+        entityManager.getRandom().setSeed(seed);
+        playerCount = std::clamp(playerCount, 1u, Components::MAX_PLAYERS);
+
+        // Create Game State Entity
+        EntityID gameStateID = entityManager.createEntity();
+        entityManager.addComponent(gameStateID, Components::GameStateComponent{playerCount});
+
+        // Every player but the local one is played by its own AI
+        for (unsigned int player = 2; player <= playerCount; ++player) {
+            EntityID enemyAI = entityManager.createEntity();
+            entityManager.addComponent(enemyAI, Components::AIComponent{Components::getPlayerFaction(player)});
+        }
+
+        // Generate Map
+        Game::GenerateRandomMap(entityManager, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, 30, 100, playerCount, hyperlanes);
+        auto& distances = entityManager.getDistances();
+        log_info << "Distance table: " << distances.size() << " structures, " << (distances.isFullMatrix() ? "full matrix, " : "nearest neighbours, ")
+                 << distances.getMemoryUsage() / 1024.f << " KB";
+
+        // Periodic work runs on the world timer wheel
+        for (EntityID factoryID : entityManager.getFactories()) {
+            Systems::ScheduleProduction(entityManager, factoryID);
+        }
+        Systems::AI::ScheduleAISystem(entityManager);
+        Systems::ScheduleGameStateSystem(entityManager);
+    }
+
+    Simulation::~Simulation() = default;
+
+    void Simulation::applyCommands(std::uint64_t tick)
+    {
+        if (replay) {
+            auto& recorded = replay->getCommands();
+            while (replayCursor < recorded.size() && recorded[replayCursor].tick <= tick) {
+                if (recorded[replayCursor].tick == tick) {
+                    pendingCommands.push_back(recorded[replayCursor]);
+                }
+                replayCursor++;
+            }
+        }
+
+        for (auto& command : pendingCommands) {
+            command.tick = tick;
+            Systems::CommandSystem(entityManager, command);
+            commandLog.add(command);
+        }
+        pendingCommands.clear();
+    }
+
+    void Simulation::step(float dt)
+    {
+        Utils::ProfileZone stepZone("Step");
+
+        // Commands are numbered with the tick they are applied in
+        std::uint64_t tick = entityManager.getTick() + 1;
+        applyCommands(tick);
+
+        entityManager.advanceTime();
+        {
+            Utils::ProfileZone zone("Timers");
+            entityManager.getTimers().advance(entityManager.getTime());
+        }
+        {
+            Utils::ProfileZone zone("Transfers");
+            Systems::DroneTransferSystem(entityManager, dt);
+        }
+        {
+            Utils::ProfileZone zone("Interception");
+            Systems::InterceptionSystem(entityManager, dt);
+        }
+        {
+            Utils::ProfileZone zone("Regions");
+            entityManager.updateDroneRegions();
+        }
+        {
+            Utils::ProfileZone zone("Combat");
+            Systems::CombatSystem(entityManager, dt);
+        }
+
+        if (Config::ENABLE_REWIND) {
+            Utils::ProfileZone zone("Rewind");
+            rewindBuffer->record(entityManager);
+        }
+
+        if (hashing) {
+            Utils::ProfileZone zone("Hash");
+            lastHash = StateHash::compute(entityManager);
+            if (hashLog) {
+                char line[200];
+                int length = std::snprintf(line, sizeof(line), "%llu %016llx", static_cast<unsigned long long>(tick), static_cast<unsigned long long>(lastHash.getTotal()));
+                for (auto part : lastHash.parts) {
+                    length += std::snprintf(line + length, sizeof(line) - length, " %016llx", static_cast<unsigned long long>(part));
+                }
+                *hashLog << line << '\n';
+            }
+        }
+    }
+
+    void Simulation::seek(double time)
+    {
+        if (rewindBuffer->empty()) {
+            return;
+        }
+
+        auto restored = rewindBuffer->seek(entityManager, time);
+
+        // The timer wheel restarts at the restored time
+        for (auto& [factoryID, due] : restored.production) {
+            Systems::ScheduleProduction(entityManager, factoryID, due);
+        }
+        if (restored.aiDecision >= 0.0) {
+            Systems::AI::ScheduleAISystem(entityManager, restored.aiDecision);
+        } else {
+            Systems::AI::ScheduleAISystem(entityManager);
+        }
+        Systems::ScheduleGameStateSystem(entityManager);
+
+        // Commands after the restored tick belong to the discarded future
+        commandLog.truncate(entityManager.getTick());
+        if (replay) {
+            auto& recorded = replay->getCommands();
+            replayCursor = 0;
+            while (replayCursor < recorded.size() && recorded[replayCursor].tick <= entityManager.getTick()) {
+                replayCursor++;
+            }
+        }
+        if (hashing) {
+            lastHash = StateHash::compute(entityManager);
+        }
+
+        log_info << "Seek to " << entityManager.getTime() << " s: replayed " << rewindBuffer->getLastSeekTicks() << " ticks in "
+                 << rewindBuffer->getLastSeekMs() << " ms, history " << rewindBuffer->getStartTime() << "-" << rewindBuffer->getEndTime() << " s, "
+                 << rewindBuffer->getMemoryUsage() / 1024 << " KB (" << rewindBuffer->getBytesPerMinute() / 1024.f << " KB/min)";
+    }
+
+    void Simulation::queueCommand(const Command& command)
+    {
+        pendingCommands.push_back(command);
+    }
+
+    std::vector<Command>& Simulation::getCommandQueue()
+    {
+        return pendingCommands;
+    }
+
+    void Simulation::setReplay(const CommandLog* log)
+    {
+        replay = log;
+        replayCursor = 0;
+    }
+
+    void Simulation::setWorkerThreads(unsigned int threads)
+    {
+        entityManager.getWorkers().setThreadCount(threads);
+    }
+
+    unsigned int Simulation::getWorkerThreads()
+    {
+        return entityManager.getWorkers().getThreadCount();
+    }
+
+    void Simulation::setHashing(bool enabled)
+    {
+        hashing = enabled;
+    }
+
+    void Simulation::setHashLog(std::ostream* stream)
+    {
+        hashLog = stream;
+        if (hashLog) {
+            hashing = true;
+        }
+    }
+
+    GameEntityManager& Simulation::getEntityManager()
+    {
+        return entityManager;
+    }
+
+    std::uint32_t Simulation::getSeed()
+    {
+        return entityManager.getRandom().getSeed();
+    }
+
+    unsigned int Simulation::getPlayerCount()
+    {
+        return entityManager.getGameState()->playerCount;
+    }
+
+    std::uint64_t Simulation::getTick()
+    {
+        return entityManager.getTick();
+    }
+
+    const StateHash& Simulation::getLastHash() const
+    {
+        return lastHash;
+    }
+
+    const CommandLog& Simulation::getCommandLog() const
+    {
+        return commandLog;
+    }
+
+    float Simulation::getHistoryLength() const
+    {
+        return rewindBuffer->empty() ? 0.f : static_cast<float>(rewindBuffer->getEndTime() - rewindBuffer->getStartTime());
+    }
+
+    float Simulation::getHistoryBytesPerMinute() const
+    {
+        return rewindBuffer->getBytesPerMinute();
+    }
+
+    std::vector<StateHash> RecordHashStream(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount, bool hyperlanes, unsigned int threads)
+    {
+        Simulation simulation(seed, playerCount, hyperlanes);
+        simulation.setWorkerThreads(threads);
+        simulation.setHashing(true);
+        simulation.setReplay(&commands);
+
+        std::vector<StateHash> hashes;
+        hashes.reserve(ticks);
+        for (std::uint64_t i = 0; i < ticks; ++i) {
+            simulation.step(Config::SIMULATION_STEP_SEC);
+            hashes.push_back(simulation.getLastHash());
+        }
+        return hashes;
+    }
+
+    std::vector<StateHash> RecordSeekHashStream(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount, bool hyperlanes, unsigned int threads)
+    {
+        Simulation simulation(seed, playerCount, hyperlanes);
+        simulation.setWorkerThreads(threads);
+        simulation.setHashing(true);
+        simulation.setReplay(&commands);
+
+        std::vector<StateHash> hashes;
+        hashes.reserve(ticks);
+        while (hashes.size() < ticks * 2 / 3) {
+            simulation.step(Config::SIMULATION_STEP_SEC);
+            hashes.push_back(simulation.getLastHash());
+        }
+        // The seek lands on a recorded tick at or before the time, clamped to the history kept
+        simulation.seek(GameEntityManager::getTickTime(ticks / 3));
+        hashes.resize(simulation.getTick());
+        while (hashes.size() < ticks) {
+            simulation.step(Config::SIMULATION_STEP_SEC);
+            hashes.push_back(simulation.getLastHash());
+        }
+        return hashes;
+    }
+
+    Divergence FindDivergence(const std::vector<StateHash>& expected, const std::vector<StateHash>& actual)
+    {
+        Divergence divergence;
+        size_t count = std::min(expected.size(), actual.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (expected[i] != actual[i]) {
+                divergence.found = true;
+                divergence.tick = i + 1;
+                divergence.expected = expected[i];
+                divergence.actual = actual[i];
+                break;
+            }
+        }
+        return divergence;
+    }
+
+    int RunDeterminismCheck(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount, bool hyperlanes, unsigned int threads)
+    {
+        log_info << "Determinism check: seed " << seed << ", " << playerCount << " players" << (hyperlanes ? " on hyperlanes, " : ", ")
+                 << ticks << " ticks, " << commands.getCommands().size() << " commands, 1 against " << threads << " threads";
+
+        auto first = RecordHashStream(seed, ticks, commands, playerCount, hyperlanes, 1);
+        auto second = RecordHashStream(seed, ticks, commands, playerCount, hyperlanes, threads);
+        auto divergence = FindDivergence(first, second);
+        const char* failedRun = "threaded run";
+        if (!divergence.found && Config::ENABLE_REWIND) {
+            divergence = FindDivergence(first, RecordSeekHashStream(seed, ticks, commands, playerCount, hyperlanes, threads));
+            failedRun = "run continued after a seek";
+        }
+
+        if (!divergence.found) {
+            log_info << "Determinism check passed, final hash " << std::hex << (first.empty() ? 0 : first.back().getTotal()) << std::dec;
+            return 0;
+        }
+
+        log_err << "Determinism check failed at tick " << divergence.tick << " in the " << failedRun;
+        for (size_t part = 0; part < StateHash::PART_COUNT; ++part) {
+            if (divergence.expected.parts[part] != divergence.actual.parts[part]) {
+                log_err << "  " << StateHash::getPartName(part) << ": " << std::hex << divergence.expected.parts[part]
+                        << " != " << divergence.actual.parts[part] << std::dec;
+            }
+        }
+        return 1;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <ostream>
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/Command.hpp"
+#include "Game/StateHash.hpp"
+#include "Config.hpp"
+
+namespace Game {
+    class RewindBuffer;
+
+    // The match itself: the world, the fixed-step systems, player commands and history.
+    // Nothing in here draws, so a match can also run headless, e.g. for the determinism check.
+    class Simulation {
+    private:
+        GameEntityManager entityManager;
+        std::unique_ptr<RewindBuffer> rewindBuffer; // Defined in Simulation.cpp only, it pulls in the entity builders
+
+        // Commands given since the last step, and every command applied so far
+        std::vector<Command> pendingCommands;
+        CommandLog commandLog;
+
+        // Recorded commands fed back in at their tick
+        const CommandLog* replay = nullptr;
+        size_t replayCursor = 0;
+
+        bool hashing = Config::ENABLE_STATE_HASH;
+        StateHash lastHash;
+        std::ostream* hashLog = nullptr;
+
+        void applyCommands(std::uint64_t tick);
+
+    public:
+        // Player 1 is the local player, players 2 to playerCount are computer players.
+        // In a hyperlane match drones only fly along the lanes between structures.
+        explicit Simulation(std::uint32_t seed, unsigned int playerCount = Config::DEFAULT_PLAYER_COUNT, bool hyperlanes = false);
+        ~Simulation();
+
+        // One fixed step: commands, timers, transfers, combat, then history and the state hash
+        void step(float dt);
+
+        // Jump to a recorded point of the match
+        void seek(double time);
+
+        // Applied at the start of the next step
+        void queueCommand(const Command& command);
+        std::vector<Command>& getCommandQueue();
+
+        // Apply the commands of a recorded match at the ticks they were given, the log must outlive the simulation
+        void setReplay(const CommandLog* log);
+
+        // Threads the per-tile and per-row work of a step is split over, the results do not depend on it
+        void setWorkerThreads(unsigned int threads);
+        unsigned int getWorkerThreads();
+
+        void setHashing(bool enabled);
+        // One line per tick: tick, total hash and the part hashes, hashing is switched on while a log is set
+        void setHashLog(std::ostream* stream);
+
+        GameEntityManager& getEntityManager();
+        std::uint32_t getSeed();
+        unsigned int getPlayerCount();
+        std::uint64_t getTick();
+        const StateHash& getLastHash() const;
+        const CommandLog& getCommandLog() const;
+
+        // Recorded history, for the HUD
+        float getHistoryLength() const;
+        float getHistoryBytesPerMinute() const;
+    };
+
+    // First tick at which two hash streams differ
+    struct Divergence {
+        bool found = false;
+        std::uint64_t tick = 0;
+        StateHash expected;
+        StateHash actual;
+    };
+
+    // Play seed and commands for the given number of ticks, the state hash after every tick
+    std::vector<StateHash> RecordHashStream(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount = Config::DEFAULT_PLAYER_COUNT, bool hyperlanes = false, unsigned int threads = 1);
+    // The same, but the match is played to two thirds, sought back to one third and played to the end again,
+    // the hashes after the seek replace the ones first recorded
+    std::vector<StateHash> RecordSeekHashStream(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount = Config::DEFAULT_PLAYER_COUNT, bool hyperlanes = false, unsigned int threads = 1);
+    Divergence FindDivergence(const std::vector<StateHash>& expected, const std::vector<StateHash>& actual);
+
+    // Play the same match twice and report the first divergent tick and state, returns the process exit code.
+    // The first run is single-threaded, the second uses the given number of threads.
+    // With rewind on, a third run seeks back midway and must continue exactly as the first run did.
+    int RunDeterminismCheck(std::uint32_t seed, std::uint64_t ticks, const CommandLog& commands, unsigned int playerCount = Config::DEFAULT_PLAYER_COUNT, bool hyperlanes = false, unsigned int threads = 1);
+}
+
+#endif // SIMULATION_HPP
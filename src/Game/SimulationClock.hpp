@@ -0,0 +1,79 @@
+#ifndef SIMULATION_CLOCK_HPP
+#define SIMULATION_CLOCK_HPP
+
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <SFML/System/Clock.hpp>
+
+#include "Config.hpp"
+
+namespace Game {
+
+    // Turns wall-clock frame time into fixed simulation steps at the selected speed.
+    // Steps stop once the frame budget is spent; the rest of the frame's time is dropped,
+    // so a match that cannot keep up runs slower instead of stalling, and the achieved speed is reported.
+    class SimulationClock {
+    public:
+        static constexpr std::array<float, 7> SPEEDS = {1.f, 2.f, 4.f, 8.f, 16.f, 32.f, 64.f};
+
+        void togglePause() { paused = !paused; }
+        void faster() { speedIndex = std::min(speedIndex + 1, SPEEDS.size() - 1); }
+        void slower() { speedIndex = speedIndex > 0 ? speedIndex - 1 : 0; }
+
+        bool isPaused() const { return paused; }
+        float getTimeScale() const { return paused ? 0.f : SPEEDS[speedIndex]; }
+        float getAchievedScale() const { return achievedScale; }
+
+        // Behind schedule recently: cosmetic work (labels, HUD, rendering) should be thinned out
+        bool isDegraded() const { return degradedFrames > 0; }
+
+        // While degraded only every n-th frame is drawn
+        bool shouldRender() const {
+            return !isDegraded() || frameCount % Config::DEGRADED_RENDER_INTERVAL == 0;
+        }
+
+        // Run the fixed steps due for a frame that took frameTime seconds of wall-clock time
+        void advance(float frameTime, const std::function<void(float)>& step) {
+            sf::Clock budget;
+            frameCount++;
+
+            // A long stall (window drag, breakpoint) is not caught up on
+            frameTime = std::min(frameTime, Config::MAX_FRAME_TIME_SEC);
+            accumulator += frameTime * getTimeScale();
+
+            float simulated = 0.f;
+            while (accumulator >= Config::SIMULATION_STEP_SEC) {
+                step(Config::SIMULATION_STEP_SEC);
+                accumulator -= Config::SIMULATION_STEP_SEC;
+                simulated += Config::SIMULATION_STEP_SEC;
+
+                if (budget.getElapsedTime().asSeconds() > Config::SIMULATION_BUDGET_SEC) {
+                    break;
+                }
+            }
+
+            if (accumulator >= Config::SIMULATION_STEP_SEC) {
+                accumulator = 0.f;
+                degradedFrames = Config::DEGRADED_HOLD_FRAMES;
+            } else if (degradedFrames > 0) {
+                degradedFrames--;
+            }
+
+            // Smoothed, so the HUD does not flicker between 0 and 2 steps per frame
+            if (frameTime > 0.f) {
+                achievedScale += (simulated / frameTime - achievedScale) * 0.1f;
+            }
+        }
+
+    private:
+        size_t speedIndex = 0;
+        bool paused = false;
+        float accumulator = 0.f;
+        float achievedScale = 1.f;
+        unsigned int degradedFrames = 0;
+        unsigned int frameCount = 0;
+    };
+}
+
+#endif // SIMULATION_CLOCK_HPP
@@ -0,0 +1,100 @@
+#ifndef STATE_HASH_HPP
+#define STATE_HASH_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include "Game/GameEntityManager.hpp"
+#include "Components/DroneTransferComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
+#include "Components/LaunchComponent.hpp"
+#include "Utils/Hash.hpp"
+
+namespace Game {
+
+    // Fingerprint of the gameplay state after a tick.
+    // Each part is hashed separately so a divergence can be traced to the state that caused it.
+    struct StateHash {
+        enum Part { CLOCK, OWNERSHIP, GARRISONS, SHIELDS, PRODUCTION, ORDERS, DRONES, PART_COUNT };
+
+        std::array<std::uint64_t, PART_COUNT> parts{};
+
+        std::uint64_t getTotal() const {
+            std::uint64_t total = 0;
+            for (auto part : parts) {
+                total = Utils::Hash::combine(total, part);
+            }
+            return total;
+        }
+
+        bool operator==(const StateHash& other) const {
+            return parts == other.parts;
+        }
+        bool operator!=(const StateHash& other) const {
+            return parts != other.parts;
+        }
+
+        static const char* getPartName(std::size_t part) {
+            static const char* names[PART_COUNT] = {"clock", "ownership", "garrisons", "shields", "production", "orders", "drones"};
+            return part < PART_COUNT ? names[part] : "unknown";
+        }
+
+        // Structures are few and rehashed in list order, the drones come from the running sum kept by the entity manager
+        static StateHash compute(GameEntityManager& entityManager) {
+            using Utils::Hash::combine;
+            using Utils::Hash::ofFloat;
+            using Utils::Hash::ofDouble;
+
+            StateHash hash;
+            auto& timers = entityManager.getTimers();
+
+            std::uint64_t& clock = hash.parts[CLOCK];
+            clock = combine(clock, entityManager.getTick());
+            clock = combine(clock, ofDouble(entityManager.getTime()));
+            if (auto* gameState = entityManager.getGameState()) {
+                clock = combine(clock, static_cast<std::uint64_t>(gameState->winner));
+                clock = combine(clock, gameState->isGameOver);
+            }
+            for (EntityID aiEntityID : entityManager.getAIEntities()) {
+                auto* ai = entityManager.getComponent<Components::AIComponent>(aiEntityID);
+                clock = combine(clock, ofDouble(timers.getDueTime(ai->decisionTimerID)));
+            }
+
+            for (EntityID id : entityManager.getGarissons()) {
+                Entity& entity = entityManager.getEntity(id);
+
+                if (auto* faction = entity.getComponent<Components::FactionComponent>()) {
+                    hash.parts[OWNERSHIP] = combine(hash.parts[OWNERSHIP], combine(id, static_cast<std::uint64_t>(faction->faction)));
+                }
+                if (auto* garisson = entity.getComponent<Components::GarissonComponent>()) {
+                    hash.parts[GARRISONS] = combine(hash.parts[GARRISONS], combine(id, garisson->getDroneCount()));
+                }
+                if (auto* shield = entity.getComponent<Components::ShieldComponent>()) {
+                    hash.parts[SHIELDS] = combine(hash.parts[SHIELDS], combine(ofFloat(shield->baseShield), ofDouble(shield->baseTime)));
+                }
+                if (auto* factory = entity.getComponent<Components::FactoryComponent>()) {
+                    hash.parts[PRODUCTION] = combine(hash.parts[PRODUCTION], combine(id, ofDouble(timers.getDueTime(factory->productionTimerID))));
+                }
+
+                std::uint64_t orders = id;
+                if (auto* transfer = entity.getComponent<Components::DroneTransferComponent>()) {
+                    orders = combine(orders, combine(transfer->target, static_cast<std::uint64_t>(transfer->faction)));
+                }
+                if (auto* attack = entity.getComponent<Components::AttackOrderComponent>()) {
+                    orders = combine(orders, combine(attack->target, 1));
+                }
+                if (auto* launch = entity.getComponent<Components::LaunchComponent>()) {
+                    orders = combine(orders, combine(launch->target, static_cast<std::uint64_t>(launch->faction)));
+                    orders = combine(orders, combine(combine(launch->waveSize, launch->remaining), combine(launch->launched, ofDouble(launch->startTime))));
+                }
+                hash.parts[ORDERS] = combine(hash.parts[ORDERS], orders);
+            }
+
+            hash.parts[DRONES] = combine(entityManager.getDrones().size(), entityManager.getDroneHash());
+            return hash;
+        }
+    };
+}
+
+#endif // STATE_HASH_HPP
@@ -0,0 +1,206 @@
+#ifndef STRUCTURE_INDEX_HPP
+#define STRUCTURE_INDEX_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+
+namespace Game {
+
+    // Structures by position for nearest-neighbour and radius queries, a k-d tree stored as a sorted array.
+    // Structures never move, the tree is built on the first query after structures were added or removed,
+    // captures only update the owner kept next to each position so queries can filter by faction.
+    // Results are sorted by distance and then by ID, equal distances are all kept.
+    class StructureIndex {
+    public:
+        using Neighbour = std::pair<float, EntityID>;   // Distance, structure
+
+        void addStructure(EntityID id, sf::Vector2f position, Components::Faction faction) {
+            auto it = index.find(id);
+            if (it != index.end()) {
+                nodes[it->second].faction = faction;
+                return;
+            }
+            index.emplace(id, nodes.size());
+            nodes.push_back(Node{id, position, faction});
+            dirty = true;
+        }
+
+        void removeStructure(EntityID id) {
+            auto it = index.find(id);
+            if (it == index.end()) {
+                return;
+            }
+            size_t node = it->second;
+            index.erase(it);
+            if (node != nodes.size() - 1) {
+                nodes[node] = nodes.back();
+                index[nodes[node].id] = node;
+            }
+            nodes.pop_back();
+            dirty = true;
+        }
+
+        // Hand a structure over on capture
+        void setFaction(EntityID id, Components::Faction faction) {
+            auto it = index.find(id);
+            if (it != index.end()) {
+                nodes[it->second].faction = faction;
+            }
+        }
+
+        // The k structures closest to the position within the distance that pass filter(id, faction), closest first
+        template<typename Filter>
+        void nearest(sf::Vector2f position, size_t k, float maxDistance, Filter filter, std::vector<Neighbour>& result) {
+            result.clear();
+            if (k == 0) {
+                return;
+            }
+            build();
+            // Max-heap of the best k found so far, the worst on top bounds the search
+            float bound = maxDistance * maxDistance;
+            searchNearest(0, nodes.size(), 0, position, k, bound, filter, result);
+            std::sort_heap(result.begin(), result.end());
+            for (auto& [distance, id] : result) {
+                distance = std::sqrt(distance);
+            }
+        }
+
+        // Every structure within the radius of the position that passes filter(id, faction), closest first
+        template<typename Filter>
+        void withinRadius(sf::Vector2f position, float radius, Filter filter, std::vector<Neighbour>& result) {
+            result.clear();
+            build();
+            searchRadius(0, nodes.size(), 0, position, radius * radius, filter, result);
+            std::sort(result.begin(), result.end());
+            for (auto& [distance, id] : result) {
+                distance = std::sqrt(distance);
+            }
+        }
+
+        size_t size() const {
+            return nodes.size();
+        }
+
+        void clear() {
+            nodes.clear();
+            index.clear();
+            dirty = false;
+        }
+
+    private:
+        struct Node {
+            EntityID id;
+            sf::Vector2f position;
+            Components::Faction faction;
+        };
+
+        // The subtree of [begin, end) at a depth has its median on the split axis at the middle,
+        // the axis alternates x, y with the depth
+        std::vector<Node> nodes;
+        std::unordered_map<EntityID, size_t> index;
+        bool dirty = false;
+
+        static float getAxis(sf::Vector2f position, size_t depth) {
+            return depth % 2 == 0 ? position.x : position.y;
+        }
+
+        static float getDistanceSquared(sf::Vector2f a, sf::Vector2f b) {
+            float dx = a.x - b.x;
+            float dy = a.y - b.y;
+            return dx * dx + dy * dy;
+        }
+
+        void build() {
+            if (!dirty) {
+                return;
+            }
+            // Start from ID order so the tree does not depend on the order structures were added in
+            std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) { return a.id < b.id; });
+            split(0, nodes.size(), 0);
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                index[nodes[i].id] = i;
+            }
+            dirty = false;
+        }
+
+        void split(size_t begin, size_t end, size_t depth) {
+            if (end - begin < 2) {
+                return;
+            }
+            size_t middle = begin + (end - begin) / 2;
+            std::nth_element(nodes.begin() + begin, nodes.begin() + middle, nodes.begin() + end, [depth](const Node& a, const Node& b) {
+                float axisA = getAxis(a.position, depth);
+                float axisB = getAxis(b.position, depth);
+                return axisA < axisB || (axisA == axisB && a.id < b.id);
+            });
+            split(begin, middle, depth + 1);
+            split(middle + 1, end, depth + 1);
+        }
+
+        template<typename Filter>
+        void searchNearest(size_t begin, size_t end, size_t depth, sf::Vector2f position, size_t k, float& bound,
+                           Filter& filter, std::vector<Neighbour>& heap) const {
+            if (begin >= end) {
+                return;
+            }
+            size_t middle = begin + (end - begin) / 2;
+            const Node& node = nodes[middle];
+
+            float distance = getDistanceSquared(node.position, position);
+            if (distance <= bound && filter(node.id, node.faction)) {
+                Neighbour candidate{distance, node.id};
+                if (heap.size() < k) {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (candidate < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                if (heap.size() == k) {
+                    bound = heap.front().first;
+                }
+            }
+
+            // Near side first, the far side only while the splitting line is within the bound, ties included
+            float offset = getAxis(position, depth) - getAxis(node.position, depth);
+            bool left = offset < 0.f;
+            searchNearest(left ? begin : middle + 1, left ? middle : end, depth + 1, position, k, bound, filter, heap);
+            if (offset * offset <= bound) {
+                searchNearest(left ? middle + 1 : begin, left ? end : middle, depth + 1, position, k, bound, filter, heap);
+            }
+        }
+
+        template<typename Filter>
+        void searchRadius(size_t begin, size_t end, size_t depth, sf::Vector2f position, float radiusSquared,
+                          Filter& filter, std::vector<Neighbour>& result) const {
+            if (begin >= end) {
+                return;
+            }
+            size_t middle = begin + (end - begin) / 2;
+            const Node& node = nodes[middle];
+
+            float distance = getDistanceSquared(node.position, position);
+            if (distance <= radiusSquared && filter(node.id, node.faction)) {
+                result.emplace_back(distance, node.id);
+            }
+
+            float offset = getAxis(position, depth) - getAxis(node.position, depth);
+            if (offset <= 0.f || offset * offset <= radiusSquared) {
+                searchRadius(begin, middle, depth + 1, position, radiusSquared, filter, result);
+            }
+            if (offset >= 0.f || offset * offset <= radiusSquared) {
+                searchRadius(middle + 1, end, depth + 1, position, radiusSquared, filter, result);
+            }
+        }
+    };
+}
+
+#endif // STRUCTURE_INDEX_HPP
@@ -0,0 +1,100 @@
+#ifndef TILE_GRID_HPP
+#define TILE_GRID_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Game/FlightTable.hpp"
+#include "Utils/WorkerPool.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // The map cut into square tiles, each holding the drones in flight above it, so per-tile work can be handed to worker threads.
+    // A drone is placed in the tile it launches from. At tick boundaries every tile checks its drones against the flight
+    // table, drops those that landed or were destroyed and posts those that left into the inbox of the tile they entered.
+    // Each source tile has its own slot in every inbox, so no two threads write the same list, and inboxes are drained
+    // in source order, the tile lists do not depend on the number of threads.
+    class TileGrid {
+    public:
+        TileGrid() {
+            columns = static_cast<int>(std::ceil(Config::MAP_WIDTH / Config::SHARD_TILE_SIZE));
+            rows = static_cast<int>(std::ceil(Config::MAP_HEIGHT / Config::SHARD_TILE_SIZE));
+            tiles.resize(columns * rows);
+            for (auto& tile : tiles) {
+                tile.inbox.resize(tiles.size());
+            }
+        }
+
+        size_t getTileCount() const {
+            return tiles.size();
+        }
+
+        // Drones off the map belong to the nearest border tile
+        size_t getTile(sf::Vector2f position) const {
+            int column = std::clamp(static_cast<int>(std::floor(position.x / Config::SHARD_TILE_SIZE)), 0, columns - 1);
+            int row = std::clamp(static_cast<int>(std::floor(position.y / Config::SHARD_TILE_SIZE)), 0, rows - 1);
+            return static_cast<size_t>(row * columns + column);
+        }
+
+        void place(EntityID droneID, sf::Vector2f position) {
+            tiles[getTile(position)].drones.push_back(droneID);
+        }
+
+        const std::vector<EntityID>& getDrones(size_t tile) const {
+            return tiles[tile].drones;
+        }
+
+        // Hand drones over to the tiles they are above at the positions of the last flight table evaluation
+        void exchange(const FlightTable& flights, Utils::WorkerPool& workers) {
+            workers.run(tiles.size(), [this, &flights](size_t index) {
+                Tile& tile = tiles[index];
+                size_t kept = 0;
+                for (EntityID droneID : tile.drones) {
+                    size_t slot = flights.getSlot(droneID);
+                    if (slot == flights.size()) {
+                        continue;
+                    }
+                    size_t destination = getTile(flights.getPosition(slot));
+                    if (destination == index) {
+                        tile.drones[kept++] = droneID;
+                    } else {
+                        tiles[destination].inbox[index].push_back(droneID);
+                    }
+                }
+                tile.drones.resize(kept);
+            });
+            workers.run(tiles.size(), [this](size_t index) {
+                Tile& tile = tiles[index];
+                for (auto& incoming : tile.inbox) {
+                    tile.drones.insert(tile.drones.end(), incoming.begin(), incoming.end());
+                    incoming.clear();
+                }
+            });
+        }
+
+        void clear() {
+            for (auto& tile : tiles) {
+                tile.drones.clear();
+                for (auto& incoming : tile.inbox) {
+                    incoming.clear();
+                }
+            }
+        }
+
+    private:
+        struct Tile {
+            std::vector<EntityID> drones;
+            std::vector<std::vector<EntityID>> inbox;   // Drones arriving from each other tile
+        };
+
+        int columns = 1;
+        int rows = 1;
+        std::vector<Tile> tiles;
+    };
+}
+
+#endif // TILE_GRID_HPP
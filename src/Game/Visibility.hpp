@@ -0,0 +1,216 @@
+#ifndef VISIBILITY_HPP
+#define VISIBILITY_HPP
+
+#include <vector>
+#include <array>
+#include <map>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+#include "Core/EntityManager.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Fog of war on a coarse grid of 64 columns, so a grid row of one faction is a single 64-bit word.
+    // Structures reveal a disc, stamped row by row into a per-faction word mask when ownership changes.
+    // Drones are counted per faction and cell, a cell's occupancy bit only flips when its count leaves or reaches 0,
+    // so only drones that cross a cell boundary cost anything. Drone vision is the occupancy grid dilated
+    // by the drone radius with shifts and ORs of whole rows, redone only for factions whose occupancy changed.
+    class Visibility {
+    public:
+        using Row = std::uint64_t;
+        using Cell = std::uint16_t;
+        static constexpr int COLUMNS = 64;
+
+        Visibility() {
+            cellSize = std::ceil(static_cast<float>(Config::MAP_WIDTH) / COLUMNS);
+            inverseCellSize = 1.f / cellSize;
+            rows = static_cast<int>(std::ceil(Config::MAP_HEIGHT / cellSize));
+            droneCounts.assign(Components::FACTION_COUNT * COLUMNS * rows, 0);
+            for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                structureRows[faction].assign(rows, 0);
+                occupiedRows[faction].assign(rows, 0);
+                visibleRows[faction].assign(rows, 0);
+            }
+            droneReach = buildReach(Config::VISION_DRONE_RADIUS);
+        }
+
+        Cell getCell(sf::Vector2f position) const {
+            int column = std::clamp(static_cast<int>(position.x * inverseCellSize), 0, COLUMNS - 1);
+            int row = std::clamp(static_cast<int>(position.y * inverseCellSize), 0, rows - 1);
+            return static_cast<Cell>(row * COLUMNS + column);
+        }
+
+        // Structures, added once and handed over on capture
+        void setStructure(EntityID id, sf::Vector2f position, Components::Faction faction) {
+            auto it = structures.find(id);
+            if (it == structures.end()) {
+                it = structures.emplace(id, Structure{faction, stamp(position, Config::VISION_STRUCTURE_RADIUS)}).first;
+            } else if (it->second.faction == faction) {
+                return;
+            }
+            dirty[static_cast<size_t>(it->second.faction)] |= STRUCTURES;
+            dirty[static_cast<size_t>(faction)] |= STRUCTURES;
+            it->second.faction = faction;
+        }
+
+        void removeStructure(EntityID id) {
+            auto it = structures.find(id);
+            if (it != structures.end()) {
+                dirty[static_cast<size_t>(it->second.faction)] |= STRUCTURES;
+                structures.erase(it);
+            }
+        }
+
+        void addDrone(Components::Faction faction, Cell cell) {
+            auto& count = droneCounts[getIndex(faction, cell)];
+            if (count++ == 0) {
+                occupiedRows[static_cast<size_t>(faction)][cell / COLUMNS] |= Row(1) << (cell % COLUMNS);
+                dirty[static_cast<size_t>(faction)] |= DRONES;
+            }
+        }
+
+        void removeDrone(Components::Faction faction, Cell cell) {
+            auto& count = droneCounts[getIndex(faction, cell)];
+            if (--count == 0) {
+                occupiedRows[static_cast<size_t>(faction)][cell / COLUMNS] &= ~(Row(1) << (cell % COLUMNS));
+                dirty[static_cast<size_t>(faction)] |= DRONES;
+            }
+        }
+
+        void moveDrone(Components::Faction faction, Cell from, Cell to) {
+            if (from != to) {
+                addDrone(faction, to);
+                removeDrone(faction, from);
+            }
+        }
+
+        // Bring the visible cells of every faction whose sources changed up to date
+        void update() {
+            for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                if (dirty[faction] == 0) {
+                    continue;
+                }
+                if (dirty[faction] & STRUCTURES) {
+                    auto& mask = structureRows[faction];
+                    std::fill(mask.begin(), mask.end(), 0);
+                    for (auto& [id, structure] : structures) {
+                        if (static_cast<size_t>(structure.faction) == faction) {
+                            for (auto& [row, bits] : structure.stamp) {
+                                mask[row] |= bits;
+                            }
+                        }
+                    }
+                }
+                auto& visible = visibleRows[faction];
+                visible = structureRows[faction];
+                dilate(occupiedRows[faction], visible);
+                dirty[faction] = 0;
+            }
+        }
+
+        bool isVisible(Components::Faction faction, sf::Vector2f position) const {
+            Cell cell = getCell(position);
+            return (visibleRows[static_cast<size_t>(faction)][cell / COLUMNS] >> (cell % COLUMNS)) & 1;
+        }
+
+        const std::vector<Row>& getVisibleRows(Components::Faction faction) const {
+            return visibleRows[static_cast<size_t>(faction)];
+        }
+
+        float getCellSize() const { return cellSize; }
+        int getRows() const { return rows; }
+
+    private:
+        enum : unsigned char { STRUCTURES = 1, DRONES = 2 };
+
+        struct Structure {
+            Components::Faction faction;
+            std::vector<std::pair<int, Row>> stamp; // Revealed columns of each row
+        };
+
+        float cellSize = 1.f;
+        float inverseCellSize = 1.f;
+        int rows = 0;
+        std::map<EntityID, Structure> structures;
+        std::vector<std::uint32_t> droneCounts;     // Per faction, then per cell
+        std::array<std::vector<Row>, Components::FACTION_COUNT> structureRows;
+        std::array<std::vector<Row>, Components::FACTION_COUNT> occupiedRows;
+        std::array<std::vector<Row>, Components::FACTION_COUNT> visibleRows;
+        std::array<unsigned char, Components::FACTION_COUNT> dirty{};
+        std::vector<int> droneReach;                // Half width in cells of the drone disc, per row offset
+
+        size_t getIndex(Components::Faction faction, Cell cell) const {
+            return static_cast<size_t>(faction) * COLUMNS * rows + cell;
+        }
+
+        // Columns first to last, inclusive and clamped to the grid
+        static Row span(int first, int last) {
+            first = std::max(first, 0);
+            last = std::min(last, COLUMNS - 1);
+            if (first > last) {
+                return 0;
+            }
+            Row upTo = last == COLUMNS - 1 ? ~Row(0) : (Row(1) << (last + 1)) - 1;
+            return upTo & ~((Row(1) << first) - 1);
+        }
+
+        std::vector<std::pair<int, Row>> stamp(sf::Vector2f position, float radius) const {
+            std::vector<std::pair<int, Row>> result;
+            int first = std::max(0, static_cast<int>((position.y - radius) / cellSize));
+            int last = std::min(rows - 1, static_cast<int>((position.y + radius) / cellSize));
+            for (int row = first; row <= last; ++row) {
+                // Widest extent of the disc within the row
+                float nearestY = std::clamp(position.y, row * cellSize, (row + 1) * cellSize);
+                float dy = nearestY - position.y;
+                float halfWidth = std::sqrt(std::max(0.f, radius * radius - dy * dy));
+                result.emplace_back(row, span(static_cast<int>((position.x - halfWidth) / cellSize), static_cast<int>((position.x + halfWidth) / cellSize)));
+            }
+            return result;
+        }
+
+        std::vector<int> buildReach(float radius) const {
+            int reach = static_cast<int>(std::ceil(radius / cellSize));
+            std::vector<int> halfWidths;
+            for (int dy = 0; dy <= reach; ++dy) {
+                float gap = std::max(0.f, (dy - 1) * cellSize);
+                halfWidths.push_back(gap > radius ? -1 : static_cast<int>(std::ceil(std::sqrt(radius * radius - gap * gap) / cellSize)));
+            }
+            return halfWidths;
+        }
+
+        // OR the occupied rows, widened into discs of the drone radius, into the visible rows
+        void dilate(const std::vector<Row>& occupied, std::vector<Row>& visible) const {
+            int reach = static_cast<int>(droneReach.size()) - 1;
+            for (int row = 0; row < rows; ++row) {
+                Row bits = occupied[row];
+                if (bits == 0) {
+                    continue;
+                }
+                // Widen once per distinct half width, the widest first
+                Row widened[COLUMNS];
+                int widest = std::min(droneReach[0], COLUMNS - 1);
+                Row current = bits;
+                for (int k = 1; k <= widest; ++k) {
+                    current |= (current << 1) | (current >> 1);
+                    widened[k] = current;
+                }
+                widened[0] = bits;
+                for (int dy = -reach; dy <= reach; ++dy) {
+                    int target = row + dy;
+                    int halfWidth = droneReach[std::abs(dy)];
+                    if (target < 0 || target >= rows || halfWidth < 0) {
+                        continue;
+                    }
+                    visible[target] |= widened[std::min(halfWidth, widest)];
+                }
+            }
+        }
+    };
+}
+
+#endif // VISIBILITY_HPP
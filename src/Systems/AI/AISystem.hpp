@@ -14,31 +14,60 @@
 #include "Systems/AI/PlanSystem.hpp"
 #include "Systems/AI/PerceptionSystem.hpp"
 
+#include "Utils/Profiler.hpp"
 #include "Config.hpp"
 
 namespace Systems::AI {
+        // One turn of every computer player, in the order the AIs were created
         void AISystem(Game::GameEntityManager& entityManager, float dt) {
+            for (EntityID aiEntityID : entityManager.getAIEntities()) {
+                // Reset last plan
+                Entity& aiEntity = entityManager.getEntity(aiEntityID);
+                auto* aiComponent = aiEntity.getComponent<Components::AIComponent>();
+                aiComponent->reset();
 
-            // Run AI every few seconds
-            static float decisionTimer = 0.f;
+                // Players that are out do not play
+                auto* gameState = entityManager.getGameState();
+                if (gameState && !gameState->isAlive(aiComponent->faction)) {
+                    continue;
+                }
 
-            decisionTimer += dt;
-            if(decisionTimer < Config::Difficulty::AI_DECISION_INTERVAL_SEC) {
-                return;
+                // Run AI
+                Utils::ProfileZone zone("AI");
+                Systems::AI::PerceptionSystem(entityManager, aiEntityID, dt);
+                Systems::AI::PlanSystem(entityManager, aiEntityID, dt);
+                Systems::AI::ExecuteSystem(entityManager, aiEntityID, dt);
             }
-            decisionTimer = 0.f;
+        }
 
-            // Reset last plan
-            Entity& aiEntity = entityManager.getAIEntity();
-            auto* aiComponent = aiEntity.getComponent<Components::AIComponent>();
-            aiComponent->reset();
+        // Due time of the next AI turn, negative when none is scheduled
+        double GetAIDecisionTime(Game::GameEntityManager& entityManager) {
+            auto& aiEntities = entityManager.getAIEntities();
+            if (aiEntities.empty()) {
+                return -1.0;
+            }
+            auto* aiComponent = entityManager.getComponent<Components::AIComponent>(aiEntities.front());
+            return entityManager.getTimers().getDueTime(aiComponent->decisionTimerID);
+        }
 
-            // Run AI
-            Systems::AI::PerceptionSystem(entityManager, dt);
-            Systems::AI::PlanSystem(entityManager, dt);
-            Systems::AI::ExecuteSystem(entityManager, dt);
+        // Run an AI turn every few seconds on the world timer wheel, all AIs share the timer.
+        // The next turn is scheduled after each run so difficulty changes apply immediately.
+        void ScheduleAISystem(Game::GameEntityManager& entityManager, double time) {
+            if (entityManager.getAIEntities().empty()) {
+                return;
+            }
+            float interval = Config::Difficulty::AI_DECISION_INTERVAL_SEC;
+            TimerID timerID = entityManager.getTimers().schedule(time, [&entityManager, interval](double time) {
+                AISystem(entityManager, interval);
+                ScheduleAISystem(entityManager, entityManager.getTime() + Config::Difficulty::AI_DECISION_INTERVAL_SEC);
+            });
+            for (EntityID aiEntityID : entityManager.getAIEntities()) {
+                entityManager.getComponent<Components::AIComponent>(aiEntityID)->decisionTimerID = timerID;
+            }
+        }
 
-            return;
+        void ScheduleAISystem(Game::GameEntityManager& entityManager) {
+            ScheduleAISystem(entityManager, entityManager.getTime() + Config::Difficulty::AI_DECISION_INTERVAL_SEC);
         }
 
 }
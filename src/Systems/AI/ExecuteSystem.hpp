@@ -7,8 +7,8 @@
 
 namespace Systems::AI {
 
-    void ExecuteSystem(Game::GameEntityManager& entityManager, float dt){
-        Entity& aiEntity = entityManager.getAIEntity();
+    void ExecuteSystem(Game::GameEntityManager& entityManager, EntityID aiEntityID, float dt){
+        Entity& aiEntity = entityManager.getEntity(aiEntityID);
         auto* aiComp = aiEntity.getComponent<Components::AIComponent>();
     
         unsigned int attackOrdersExecuted = 0;
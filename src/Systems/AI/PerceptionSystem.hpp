@@ -6,118 +6,98 @@
 #include "Components/GarissonComponent.hpp"
 #include "Components/FactionComponent.hpp"
 #include "Components/AIComponent.hpp"
+#include "Components/LaunchComponent.hpp"
+#include "Config.hpp"
 
 #include "Utils/Logger.hpp"
 
 namespace Systems::AI {
 
-    float getDistanceBetweenEntities(Game::GameEntityManager& entityManager, EntityID entity1, EntityID entity2){
-        auto* entity1Transform = entityManager.getEntity(entity1).getComponent<Components::TransformComponent>();
-        auto* entity2Transform = entityManager.getEntity(entity2).getComponent<Components::TransformComponent>();
-
-        return sqrtf(powf(entity1Transform->getPosition().x - entity2Transform->getPosition().x, 2) + powf(entity1Transform->getPosition().y - entity2Transform->getPosition().y, 2));
-    }
-    
-    void PerceptionSystem(Game::GameEntityManager& entityManager, float dt){
-        Entity& aiEntity = entityManager.getAIEntity();
+    void PerceptionSystem(Game::GameEntityManager& entityManager, EntityID aiEntityID, float dt){
+        Entity& aiEntity = entityManager.getEntity(aiEntityID);
         auto* aiComp = aiEntity.getComponent<Components::AIComponent>();
 
         if(!aiComp){
             log_err << "Failed to get aiComponent";
         }
+        auto aiFaction = aiComp->faction;
 
-        auto& entities = entityManager.getAllEntities();
-
-        for(auto& [id, entity] : entities){
+        // Structures only, drones in flight are counted from the per-faction totals
+        for(EntityID id : entityManager.getGarissons()){
+            Entity& entity = entityManager.getEntity(id);
             auto* garisson = entity.getComponent<Components::GarissonComponent>();
             auto* faction = entity.getComponent<Components::FactionComponent>();
+            if(!faction || faction->faction == Components::Faction::NEUTRAL){
+                continue;
+            }
+            bool isAI = faction->faction == aiFaction;
 
             // Get drone counts in garrisons for faction
-            if(garisson && garisson->getDroneCount() > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
-                
+            if(garisson && garisson->getDroneCount() > 0){
+
                 aiComp->perception.garissonByDroneCount[id] = garisson->getDroneCount();
 
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalDrones += garisson->getDroneCount();
-                    aiComp->perception.playerGarissons.insert(id);
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
+                if(isAI){
                     aiComp->perception.aiTotalDrones += garisson->getDroneCount();
-                    aiComp->perception.aiGarissons.insert(id);
-                }
-            }
-
-            // Add in flight drones
-            auto* droneComp = entity.getComponent<Components::DroneComponent>();
-            if(droneComp && faction && faction->faction != Components::Faction::NEUTRAL){
-
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalDrones += 1;
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiTotalDrones += 1;
+                    aiComp->perception.aiGarissons.push_back(id);
+                } else {
+                    aiComp->perception.playerTotalDrones += garisson->getDroneCount();
+                    aiComp->perception.playerGarissons.push_back(id);
                 }
             }
 
             // Get total production rate
             auto* factory = entity.getComponent<Components::FactoryComponent>();
-            if(factory && factory->droneProductionRate > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
-
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerDroneProductionRate += factory->droneProductionRate;
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiDroneProductionRate += factory->droneProductionRate;
-                }
+            if(factory && factory->droneProductionRate > 0){
+                (isAI ? aiComp->perception.aiDroneProductionRate : aiComp->perception.playerDroneProductionRate) += factory->droneProductionRate;
             }
 
             auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>();
-            if(powerPlant && powerPlant->capacity > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
+            if(powerPlant && powerPlant->capacity > 0){
+                (isAI ? aiComp->perception.aiTotalEnergy : aiComp->perception.playerTotalEnergy) += powerPlant->capacity;
+            }
+        }
 
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalEnergy += powerPlant->capacity;
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiTotalEnergy += powerPlant->capacity;
-                }
+        // Add in flight drones
+        auto* gameState = entityManager.getGameState();
+        for(size_t index = 0; index < Components::FACTION_COUNT; ++index){
+            auto faction = static_cast<Components::Faction>(index);
+            int inFlight = gameState->inFlightDrones[faction];
+            if(faction == Components::Faction::NEUTRAL || inFlight <= 0){
+                continue;
             }
+            (faction == aiFaction ? aiComp->perception.aiTotalDrones : aiComp->perception.playerTotalDrones) += static_cast<unsigned int>(inFlight);
         }
 
-        // Compute the garissonByDistance for ai garissons
+        // The closest other players' and neutral garissons around each ai garisson, ai garissons never count themselves
+        auto& structures = entityManager.getStructureIndex();
+        auto notAI = [aiFaction](EntityID, Components::Faction faction) { return faction != aiFaction; };
         for(auto aiGarissonID : aiComp->perception.aiGarissons){
-            auto& aiGarisson = entityManager.getEntity(aiGarissonID);
-
-            for(auto& [targetEntityID, targetEntity] : entities){
-                auto* targetGarissonComp = targetEntity.getComponent<Components::GarissonComponent>();
-                auto* targetFaction = targetEntity.getComponent<Components::FactionComponent>();
-
-                if(!targetGarissonComp || aiGarissonID == targetEntityID){
-                    // consider garissons only
-                    continue;
-                }
-
-                if(targetFaction && targetFaction->faction == Components::Faction::PLAYER_2){
-                    // consider only player 1 and neutral only
-                    continue;
-                }
-
-                auto distance = getDistanceBetweenEntities(entityManager, aiGarissonID, targetEntityID);
-                aiComp->perception.garissonsByDistance[aiGarissonID][distance] = targetEntityID;
-                // log_info << "Garisson:" << aiGarissonID << " -> " << targetEntityID << " : " << distance;
+            auto* transform = entityManager.getComponent<Components::TransformComponent>(aiGarissonID);
+            if(!transform){
+                continue;
             }
+            structures.nearest(transform->getPosition(), Config::AI_TARGETS_PER_GARRISON, Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK,
+                               notAI, aiComp->perception.garissonsByDistance[aiGarissonID]);
+
+            auto nearby = entityManager.getRegions().query(transform->getPosition(), Config::STRENGTH_RADIUS,
+                                                           Game::RegionTree::getOpponents(aiFaction), entityManager.getTime());
+            aiComp->perception.threatByGarisson[aiGarissonID] = nearby.inFlightDrones;
         }
 
-        // Get all attack orders
-        for(auto& [id, entity] : entities){
-            auto *attackOrder = entity.getComponent<Components::AttackOrderComponent>();
+        // Get all attack orders: those placed this tick and the waves still launching
+        for(EntityID id : entityManager.getGarissons()){
+            Entity& entity = entityManager.getEntity(id);
             auto* faction = entity.getComponent<Components::FactionComponent>();
-            if(attackOrder && faction){
-                if(faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerAttackOrders.insert({attackOrder->origin, attackOrder->target,0.f ,0.f});
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiAttackOrders.insert({attackOrder->origin, attackOrder->target, 0.f, 0.f});
-                }
+            if(!faction){
+                continue;
+            }
+            auto& orders = faction->faction == aiFaction ? aiComp->perception.aiAttackOrders : aiComp->perception.playerAttackOrders;
+            if(auto* attackOrder = entity.getComponent<Components::AttackOrderComponent>()){
+                orders.insert({attackOrder->origin, attackOrder->target, 0.f, 0.f});
+            }
+            if(auto* launch = entity.getComponent<Components::LaunchComponent>(); launch && launch->faction == faction->faction){
+                orders.insert({id, launch->target, 0.f, 0.f});
             }
         }
     }
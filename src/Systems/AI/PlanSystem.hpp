@@ -2,11 +2,15 @@
 #define AI_PLAN_SYSTEM_HPP
 
 #include <map>
+#include <vector>
+#include <algorithm>
 
 #include "Game/GameEntityManager.hpp"
 
 #include "Components/GarissonComponent.hpp"
 
+#include "Utils/AttackCostKernel.hpp"
+
 #include "Utils/Logger.hpp"
 #include "Utils/Random.hpp"
 #include "Config.hpp"
@@ -22,27 +26,63 @@ namespace Systems::AI {
         DISTANCE = 5,
     };
 
-    float computeAttackCost(Game::GameEntityManager& entityManager, EntityID targetEntityID, float distance) {
-        // returns how many drones it would take to conquer the target
+    // Distances and drone costs of every candidate pair the perception found, garisson by garisson
+    // in perception order and each garisson's targets closest first
+    struct AttackCosts {
+        std::vector<float> distance, travelTime, drones, shield, regenRate, cost;
 
-        auto* targetGarisson = entityManager.getEntity(targetEntityID).getComponent<Components::GarissonComponent>();
-        auto* targetShield = entityManager.getEntity(targetEntityID).getComponent<Components::ShieldComponent>();
+        float getDistance(size_t pair) const { return distance[pair]; }
+        float getCost(size_t pair) const { return cost[pair]; }
+    };
 
-        // compute drone cost
-        auto droneCost = targetGarisson->getDroneCount();
-        
-        // compute shield cost
-        auto currentShield = targetShield->currentShield;
+    void computeAttackCosts(Game::GameEntityManager& entityManager, const Components::AIPerception& perception, AttackCosts& costs) {
+        // how many drones it would take to conquer each target, its drones, its shield and
+        // what the shield regenerates while the drones fly there
+
+        // One lookup per target instead of one per pair
+        std::vector<EntityID> targets;
+        for(auto& [originGarissonID, candidates] : perception.garissonsByDistance){
+            for(auto [distance, targetEntityID] : candidates){
+                targets.push_back(targetEntityID);
+            }
+        }
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+        auto now = entityManager.getTime();
+        std::vector<float> targetDrones, targetShield, targetRegenRate;
+        for(auto targetEntityID : targets){
+            Entity& target = entityManager.getEntity(targetEntityID);
+            auto* garisson = target.getComponent<Components::GarissonComponent>();
+            auto* shield = target.getComponent<Components::ShieldComponent>();
+            targetDrones.push_back(static_cast<float>(garisson->getDroneCount()));
+            targetShield.push_back(shield->getShield(now));
+            targetRegenRate.push_back(shield->regenRate);
+        }
 
-        // compute shield regen cost (for drone travel time)
-        auto timeToReachTarget = distance / Config::DRONE_SPEED;
-        auto shieldRegenRate = targetShield->regenRate;
-        auto shieldRegenCost = timeToReachTarget * shieldRegenRate;
+        // Distances and flight times from the table, the target's values gathered next to them
+        auto& distances = entityManager.getDistances();
+        for(auto& [originGarissonID, candidates] : perception.garissonsByDistance){
+            for(auto [distance, targetEntityID] : candidates){
+                auto entry = distances.get(originGarissonID, targetEntityID);
+                size_t column = std::lower_bound(targets.begin(), targets.end(), targetEntityID) - targets.begin();
+                costs.distance.push_back(entry.distance);
+                costs.travelTime.push_back(entry.travelTime);
+                costs.drones.push_back(targetDrones[column]);
+                costs.shield.push_back(targetShield[column]);
+                costs.regenRate.push_back(targetRegenRate[column]);
+            }
+        }
 
-        return droneCost + currentShield + shieldRegenCost;
+        costs.cost.resize(costs.distance.size());
+        Utils::Kernels::AttackCostBatch batch{
+            costs.travelTime.data(), costs.drones.data(), costs.shield.data(), costs.regenRate.data(), costs.cost.size(),
+            costs.cost.data()
+        };
+        Utils::Kernels::computeAttackCosts(batch);
     }
 
-    std::unordered_map<Strategy, float> computeStrategyPriorities(Game::GameEntityManager& entityManager) {
+    std::unordered_map<Strategy, float> computeStrategyPriorities(Game::GameEntityManager& entityManager, EntityID aiEntityID) {
         std::unordered_map<Strategy, float> priorities = {
             {Strategy::ENERGY, 0.f},
             {Strategy::PRODUCTION, 0.f},
@@ -50,7 +90,7 @@ namespace Systems::AI {
             {Strategy::ATTACK, 0.f},
         };
         
-        Entity& aiEntity = entityManager.getAIEntity();
+        Entity& aiEntity = entityManager.getEntity(aiEntityID);
         auto* aiComp = aiEntity.getComponent<Components::AIComponent>();
 
         // Compute total droens in 5 seconds if no attack planned
@@ -105,8 +145,8 @@ namespace Systems::AI {
         };
     }
 
-    void PlanSystem(Game::GameEntityManager& entityManager, float dt){
-        Entity& aiEntity = entityManager.getAIEntity();
+    void PlanSystem(Game::GameEntityManager& entityManager, EntityID aiEntityID, float dt){
+        Entity& aiEntity = entityManager.getEntity(aiEntityID);
         auto* aiComp = aiEntity.getComponent<Components::AIComponent>();
 
         if(!aiComp){
@@ -119,27 +159,33 @@ namespace Systems::AI {
         std::set<Components::AI::AttackPair, Components::AI::ComparatorPairByCost> potentialFailedSingleAttackTargetsByCost;
 
         // Strategy: need energy or more factories?
-        auto priorities = computeStrategyPriorities(entityManager);
+        auto priorities = computeStrategyPriorities(entityManager, aiEntityID);
         auto strategy = std::max_element(priorities.begin(), priorities.end(), [](const std::pair<Strategy, float>& a, const std::pair<Strategy, float>& b) { return a.second < b.second; })->first;
 
         // logStrategy(strategy);
 
         // Plan: Check if any single garisson can conquer an adjacent target and save it
         // if not, save it to potential failed attacks
+        AttackCosts attackCosts;
+        computeAttackCosts(entityManager, aiComp->perception, attackCosts);
+
+        size_t pairIndex = 0;
         for(auto it = aiComp->perception.garissonsByDistance.begin(); it != aiComp->perception.garissonsByDistance.end(); it++){
             auto originGarissonID = it->first;
 
-            for(auto [distance, targetEntityID] : it->second){
-                float costForSuccesfulAttack = computeAttackCost(entityManager, targetEntityID, distance);
+            for(auto& target : it->second){
+                auto targetEntityID = target.second;
+                float distance = attackCosts.getDistance(pairIndex);
+                float costForSuccesfulAttack = attackCosts.getCost(pairIndex);
+                pairIndex++;
                 costForSuccesfulAttack += 1.f; // add some buffer
 
                 auto droneCountAtThisGarisson = aiComp->perception.garissonByDroneCount.at(originGarissonID);
-
-                auto* originTransform = entityManager.getEntity(originGarissonID).getComponent<Components::TransformComponent>();
-                auto* targetTransform = entityManager.getEntity(targetEntityID).getComponent<Components::TransformComponent>();
+                // Keep enough drones home to meet the opponents' drones flying nearby
+                auto threatAtThisGarisson = aiComp->perception.threatByGarisson[originGarissonID];
 
                 auto pair = Components::AI::AttackPair(originGarissonID, targetEntityID, distance, costForSuccesfulAttack);
-                if(droneCountAtThisGarisson > costForSuccesfulAttack){
+                if(droneCountAtThisGarisson > costForSuccesfulAttack + threatAtThisGarisson){
                     // log_info << "Can conquer " << targetEntityID << " from " << originGarissonID << ", dist: " << distance;
                     potentialSuccesfulSingleAttackTargetsByDistance.insert(pair);
                 }else{
@@ -256,7 +302,7 @@ namespace Systems::AI {
                 for(auto& garisson : aiComp->perception.aiGarissons){
                     if(garisson == consolidationSource) continue; // cannot consolidate with self
                     
-                    auto consolidatePair = Components::AI::AttackPair(garisson, consolidationSource, distance, cost);
+                    auto consolidatePair = Components::AI::AttackPair(garisson, consolidationSource, entityManager.getDistances().getDistance(garisson, consolidationSource), cost);
                     aiComp->execute.finalTargets.push_back(consolidatePair);
                     // log_info << "consolidating (source, target, distance, cost):" << consolidatePair.source << ", " << consolidatePair.target << ", " << consolidatePair.distance << ", " << consolidatePair.cost;
                 }
@@ -3,135 +3,224 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
+#include <vector>
+#include <cmath>
 
 #include "Core/Entity.hpp"
 
 #include "Components/MoveComponent.hpp"
 #include "Components/AttackOrderComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/LaunchComponent.hpp"
+#include "Components/TransformComponent.hpp"
 #include "Core/Entity.hpp"
 
+#include "Systems/ProductionSystem.hpp"
+
 #include "Utils/Logger.hpp"
 
 namespace Systems {
+
+        // Resolve every drone that landed on a target this tick, in arrival order.
+        // Drone by drone, the rules are:
+        //   same faction          -> park
+        //   shield above 1        -> shield loses 1, drone lost
+        //   shield at or below 1  -> shield drops to 0, then
+        //                            parked drones left ? one of them and the drone die : capture and park
+        // A run of consecutive drones of one faction is resolved in closed form,
+        // the results are written back to the target and the faction aggregates once.
+        void ResolveArrivals(Game::GameEntityManager& entityManager, EntityID targetID, const std::vector<Components::Faction>& drones, double now) {
+            Entity& targetEntity = entityManager.getEntity(targetID);
+
+            auto* targetFaction = targetEntity.getComponent<Components::FactionComponent>();
+            auto* targetGarisson = targetEntity.getComponent<Components::GarissonComponent>();
+            auto* targetShield = targetEntity.getComponent<Components::ShieldComponent>();
+
+            if(!targetShield){
+                log_err << "EntityID: " << targetID << " has no shield, but is the target of an attack order";
+            }
+            if (!targetGarisson || !targetFaction) {
+                return;
+            }
+
+            Components::Faction owner = targetFaction->faction;
+            size_t garrison = targetGarisson->getDroneCount();
+            float shield = targetShield ? targetShield->getShield(now) : 0.f;
+            bool shieldHit = false;
+            bool captured = false;
+
+            size_t i = 0;
+            while (i < drones.size()) {
+                Components::Faction faction = drones[i];
+                size_t count = 1;
+                while (i + count < drones.size() && drones[i + count] == faction) {
+                    count++;
+                }
+                i += count;
+
+                if (faction == owner) {
+                    // Same faction, park drones
+                    garrison += count;
+                    continue;
+                }
+
+                // Every drone is absorbed while the shield is above 1 before the hit.
+                // Subtracting whole points is exact in float, so this matches hitting the shield one drone at a time.
+                shieldHit = true;
+                size_t absorbed = 0;
+                if (shield > 1.f) {
+                    absorbed = std::min(count, static_cast<size_t>(std::ceil(shield - 1.f)));
+                    shield -= static_cast<float>(absorbed);
+                }
+                size_t remaining = count - absorbed;
+                if (remaining == 0) {
+                    continue;
+                }
+                shield = 0.f;
+
+                // Shield is down, each drone kills one parked drone
+                size_t killed = std::min(remaining, garrison);
+                garrison -= killed;
+                remaining -= killed;
+
+                // No shield, no drones, the first survivor switches factions and the rest park
+                if (remaining > 0) {
+                    owner = faction;
+                    garrison = remaining;
+                    captured = true;
+                }
+            }
+
+            if (shieldHit && targetShield) {
+                entityManager.setShield(targetID, shield, now);
+            }
+            if (owner != targetFaction->faction) {
+                entityManager.setGarrisonDrones(targetID, 0);
+                entityManager.setOwner(targetID, owner);
+            }
+            entityManager.setGarrisonDrones(targetID, static_cast<unsigned int>(garrison));
+
+            // Captured factories start producing for their new owner
+            if (captured) {
+                Systems::ScheduleProduction(entityManager, targetID);
+            }
+        }
+
         void CombatSystem(Game::GameEntityManager& entityManager, float dt) {
 
-            std::unordered_set<EntityID> toRemove;
+            double now = entityManager.getTime();
 
-            auto& entities = entityManager.getAllEntities();
-        
-            for (auto& [id, entity] : entities) {
+            // Attack orders placed at garissons start a wave, every drone but one leaves
+            for (EntityID id : entityManager.getGarissons()) {
+                Entity& entity = entityManager.getEntity(id);
                 auto* attackOrder = entity.getComponent<Components::AttackOrderComponent>();
                 auto* originGarisson = entity.getComponent<Components::GarissonComponent>();
-                auto* drone = entity.getComponent<Components::DroneComponent>();
-                auto* move = entity.getComponent<Components::MoveComponent>();
-
-                if (attackOrder && originGarisson) {
-                    // log_info << "Garisson has attack order";
-                    // Attack order was just palced at a garison
-                    // Create drones and send them to the target
-                    if (originGarisson->getDroneCount() < 2) {
-                        // log_info << "EntityID: " << id << " has no drones, removing attack order";
-                        entityManager.removeComponent<Components::AttackOrderComponent>(id);
-                        continue;
-                    }
-
-                    Entity& originEntity = entityManager.getEntity(attackOrder->origin);
-                    Entity& targetEntity = entityManager.getEntity(attackOrder->target);
+                auto* originFaction = entity.getComponent<Components::FactionComponent>();
+                if (!attackOrder) {
+                    continue;
+                }
+                EntityID target = attackOrder->target;
+                entityManager.removeComponent<Components::AttackOrderComponent>(id);
+                if (!originGarisson || !originFaction || originGarisson->getDroneCount() < 2) {
+                    continue;
+                }
 
-                    auto* originFaction = originEntity.getComponent<Components::FactionComponent>();
-                    auto* targetFaction = targetEntity.getComponent<Components::FactionComponent>();
+                // Drone transfers order again every tick, a wave to the same target only takes in the newly parked drones
+                unsigned int waveSize = originGarisson->getDroneCount() - 1;
+                auto* launch = entity.getComponent<Components::LaunchComponent>();
+                if (launch && launch->target == target && launch->faction == originFaction->faction) {
+                    launch->remaining = std::max(launch->remaining, waveSize);
+                } else {
+                    entityManager.addComponent(id, Components::LaunchComponent{target, originFaction->faction, waveSize, now});
+                }
+            }
 
-                    // TODO: insert error msg if originFaction is missing
-                    auto dronesUsedForAttack = originGarisson->getDroneCount()-1;
+            // Waves stream out at the launch rate, sharing one budget per tick.
+            // The first wave served moves round the garissons from tick to tick, so none is starved.
+            auto& garissons = entityManager.getGarissons();
+            unsigned int budget = Config::LAUNCH_BUDGET_PER_TICK;
+            size_t first = garissons.empty() ? 0 : entityManager.getTick() % garissons.size();
+            for (size_t k = 0; k < garissons.size() && budget > 0; ++k) {
+                EntityID id = garissons[(first + k) % garissons.size()];
+                Entity& entity = entityManager.getEntity(id);
+                auto* launch = entity.getComponent<Components::LaunchComponent>();
+                if (!launch) {
+                    continue;
+                }
+                auto* originGarisson = entity.getComponent<Components::GarissonComponent>();
+                auto* originFaction = entity.getComponent<Components::FactionComponent>();
+                auto* originTransform = entity.getComponent<Components::TransformComponent>();
+                auto* targetTransform = entityManager.getComponent<Components::TransformComponent>(launch->target);
+
+                // Captured or emptied on the way out, the rest of the wave stays
+                if (!originGarisson || !originFaction || !originTransform || !targetTransform
+                    || originFaction->faction != launch->faction || originGarisson->getDroneCount() < 2) {
+                    entityManager.removeComponent<Components::LaunchComponent>(id);
+                    continue;
+                }
 
-                    for(auto i=0; i < dronesUsedForAttack; i++){
-                        EntityID droneID = Game::createDrone(entityManager, std::to_string(i), originFaction->faction);
-                        Entity& droneEntity = entityManager.getEntity(droneID);
+                unsigned int count = std::min({launch->getAllowance(now, Config::LAUNCH_RATE), launch->remaining, originGarisson->getDroneCount() - 1, budget});
+                sf::Vector2f originPosition = originTransform->getPosition();
+                sf::Vector2f targetPosition = targetTransform->getPosition();
+                int spread = std::min(25 + static_cast<int>(launch->waveSize) * 5, 75);
+                auto& random = entityManager.getRandom();
+                for (unsigned int i = 0; i < count; ++i) {
+                    sf::Vector2f randomOffset = sf::Vector2f(
+                        random.getInt(-spread, spread),
+                        random.getInt(-spread, spread)
+                    );
+                    Game::launchDrone(entityManager, launch->faction, id, launch->target, originPosition + randomOffset, targetPosition, now, launch->startTime, std::to_string(launch->launched + i));
+                }
+                entityManager.addGarrisonDrones(id, -static_cast<int>(count));
+                launch->launched += count;
+                launch->remaining -= count;
+                budget -= count;
 
-                        entityManager.addComponent(droneID,Components::AttackOrderComponent{attackOrder->origin, attackOrder->target});
+                if (launch->remaining == 0) {
+                    entityManager.removeComponent<Components::LaunchComponent>(id);
+                }
+            }
 
-                        sf::Vector2f originPosition = originEntity.getComponent<Components::TransformComponent>()->transform.getPosition();
-                        int spread = 25 + (dronesUsedForAttack * 5);
-                        spread = std::min(spread, 75);
-                        sf::Vector2f randomOffset = sf::Vector2f(
-                            rand() % (2 * spread) - spread,
-                            rand() % (2 * spread) - spread
-                        );
+            // Collect the drones whose arrival time has come, grouped per target in arrival order
+            auto& arrivals = entityManager.getArrivals();
+            std::vector<EntityID> landed;
+            std::vector<EntityID> targets;
+            std::unordered_map<EntityID, std::vector<Components::Faction>> waves;
 
-                        auto* droneTransform = droneEntity.getComponent<Components::TransformComponent>();
-                        droneTransform->transform.setPosition(originPosition + randomOffset);
+            while (arrivals.hasDue(now)) {
+                EntityID id = arrivals.pop().droneID;
+                if (!entityManager.hasEntity(id)) {
+                    continue;
+                }
 
-                        auto* droneMove = droneEntity.getComponent<Components::MoveComponent>();
-                        droneMove->targetPosition = targetEntity.getComponent<Components::TransformComponent>()->transform.getPosition();
-                        droneMove->moveToTarget = true;
-                    }
-                    originGarisson->setDroneCount(1);
-                    entityManager.removeComponent<Components::AttackOrderComponent>(id);
+                Entity& entity = entityManager.getEntity(id);
+                auto* attackOrder = entity.getComponent<Components::AttackOrderComponent>();
+                auto* move = entity.getComponent<Components::MoveComponent>();
+                if (!attackOrder || !move) {
+                    continue;
                 }
-                else if (attackOrder && drone && move) {
-                    if (!move->moveToTarget) {
-                        // Drone Reached destination
-
-                        Entity& originEntity = entityManager.getEntity(attackOrder->origin);
-                        Entity& targetEntity = entityManager.getEntity(attackOrder->target);
-                        
-                        auto* originFaction = entity.getComponent<Components::FactionComponent>(); // Get the faction of the drone, in case the origin entity changed factions
-                        auto* targetFaction = targetEntity.getComponent<Components::FactionComponent>();
-                        auto* targetGarisson = targetEntity.getComponent<Components::GarissonComponent>();
-                        auto* targetShield = targetEntity.getComponent<Components::ShieldComponent>();
-        
-                        if(!targetShield){
-                            log_err << "EntityID: " << id << " has no shield, but has an attack order";
-                        }
-
-                        if (targetGarisson && originFaction && targetFaction) {
-                            
-                            // No matter what, drone entity needs to be removed
-                            toRemove.insert(id);
-
-                            auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
-
-                            if(originFaction->faction == targetFaction->faction){
-                                // Same faction, park drones
-                                targetGarisson->incrementDroneCount();
-                                continue; 
-                            }
-                            
-                            // If shield is positive, hit shield and update its value
-                            if(targetShield->getShield() > 1.f){
-                                targetShield->decrementShield();
-                            }else{
-                                targetShield->setShield(0.f); 
-                            }
-                            
-                            if(targetShield->getShield() > 0.f){
-                                // Shield was hit but still up, attacking player loses drones
-                                gameState->playerDrones[originFaction->faction]--;
-
-                            }else if(targetGarisson->getDroneCount() > 0){
-                                // Shield is down
-                                // Different faction has drones parked
-                                // Kill drones
-                                targetGarisson->decrementDroneCount();
-
-                                // both players lose drones
-                                gameState->playerDrones[originFaction->faction]--;
-                                gameState->playerDrones[targetFaction->faction]--;
-                            }else{
-                                // Different Faction, no shield, no drones, switch factions
-                                targetFaction->faction = originFaction->faction;
-                                targetGarisson->incrementDroneCount();
-                            }
-                            
-                        }
+
+                // Get the faction of the drone, in case the origin entity changed factions
+                auto* droneFaction = entity.getComponent<Components::FactionComponent>();
+                if (droneFaction) {
+                    auto& wave = waves[attackOrder->target];
+                    if (wave.empty()) {
+                        targets.push_back(attackOrder->target);
                     }
+                    wave.push_back(droneFaction->faction);
                 }
+
+                // No matter what, drone entity needs to be removed
+                landed.push_back(id);
             }
 
-            for (const auto& id : toRemove) {
-                entityManager.removeEntity(id);
+            for (EntityID targetID : targets) {
+                ResolveArrivals(entityManager, targetID, waves[targetID], now);
             }
+
+            // Removed last so a drone that captures a structure is never counted as lost first
+            entityManager.removeEntities(landed);
         }
 
 }
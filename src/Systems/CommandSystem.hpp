@@ -0,0 +1,41 @@
+#ifndef COMMAND_SYSTEM_HPP
+#define COMMAND_SYSTEM_HPP
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/Command.hpp"
+
+#include "Components/FactionComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
+#include "Components/DroneTransferComponent.hpp"
+
+namespace Systems {
+
+    // Turn a queued player command into orders on the world.
+    // The source may have changed hands since the command was given, such commands are dropped.
+    void CommandSystem(Game::GameEntityManager& entityManager, const Game::Command& command) {
+        auto* faction = entityManager.getComponent<Components::FactionComponent>(command.source);
+        if (!faction || faction->faction != command.faction) {
+            return;
+        }
+
+        switch (command.type) {
+            case Game::Command::Type::ATTACK:
+                if (entityManager.hasEntity(command.target)) {
+                    entityManager.addComponent(command.source, Components::AttackOrderComponent{command.source, command.target});
+                }
+                break;
+            case Game::Command::Type::TRANSFER:
+                if (entityManager.hasEntity(command.target)) {
+                    entityManager.addComponent(command.source, Components::DroneTransferComponent(command.source, command.target, command.faction));
+                }
+                break;
+            case Game::Command::Type::CANCEL_TRANSFER:
+                if (entityManager.getComponent<Components::DroneTransferComponent>(command.source)) {
+                    entityManager.removeComponent<Components::DroneTransferComponent>(command.source);
+                }
+                break;
+        }
+    }
+}
+
+#endif // COMMAND_SYSTEM_HPP
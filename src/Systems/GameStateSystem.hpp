@@ -1,47 +1,103 @@
 #ifndef WINNING_CONDITIONS_SYSTEM_HPP
 #define WINNING_CONDITIONS_SYSTEM_HPP
 
+#include <vector>
 #include <unordered_map>
+
 #include "Game/GameEntityManager.hpp"
 #include "Components/FactionComponent.hpp"
+#include "Components/GameStateComponent.hpp"
+#include "Utils/Logger.hpp"
 
 namespace Systems {
 
+    // The per-faction aggregates and the game over flag are maintained incrementally by the GameEntityManager.
+    // Debug builds cross-check them against a full scan of the entities.
+#ifndef NDEBUG
     void GameStateSystem(Game::GameEntityManager& entityManager, float dt) {
-
-        static float timer = 0.f;
-        // Run this check every 5 seconds
-        if(timer < 5.f){
-            timer += dt;
+        auto* gameState = entityManager.getGameState();
+        if (!gameState) {
             return;
         }
-        timer = 0.f;
-
-        std::unordered_map<Components::Faction, unsigned int> units;
 
-        // check if both players have units on the map
-            
-        for(auto& [id, entity] : entityManager.getAllEntities()) {
+        Components::PerFaction<int> energy, structures, garrisoned, inFlight;
+        for (auto& [id, entity] : entityManager.getAllEntities()) {
             auto* faction = entity.getComponent<Components::FactionComponent>();
-            if (faction) {
-                units[faction->faction] += 1;
+            if (!faction) {
+                continue;
+            }
+            if (auto* garisson = entity.getComponent<Components::GarissonComponent>()) {
+                structures[faction->faction]++;
+                garrisoned[faction->faction] += garisson->getDroneCount();
+                if (auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>()) {
+                    energy[faction->faction] += powerPlant->capacity;
+                }
+            } else if (entity.hasComponent<Components::DroneComponent>()) {
+                inFlight[faction->faction]++;
             }
         }
 
-        if(units[Components::Faction::PLAYER_1] == 0) {
-            // Player1 has lost
-            auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
-            gameState->winner = Components::Faction::PLAYER_2;
-            gameState->isGameOver = true;
-        }
+        auto verify = [](const char* name, const Components::PerFaction<int>& tracked, const Components::PerFaction<int>& scanned) {
+            for (size_t faction = 0; faction < Components::FACTION_COUNT; ++faction) {
+                if (tracked.values[faction] != scanned.values[faction]) {
+                    log_err << name << " of faction " << faction << " is " << tracked.values[faction] << ", scan found " << scanned.values[faction];
+                }
+            }
+        };
+        verify("Energy capacity", gameState->playerEnergy, energy);
+        verify("Structure count", gameState->structureCount, structures);
+        verify("Garrisoned drones", gameState->garrisonedDrones, garrisoned);
+        verify("In-flight drones", gameState->inFlightDrones, inFlight);
 
-        if (units[Components::Faction::PLAYER_2] == 0) {
-            // Player2 has lost
-            auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
-            gameState->winner = Components::Faction::PLAYER_1;
-            gameState->isGameOver = true;
+        // Power grids, flooded from every structure along the links to structures of the same owner
+        auto& powerGrid = entityManager.getPowerGrid();
+        std::unordered_map<EntityID, int> gridCapacity;
+        for (EntityID id : entityManager.getGarissons()) {
+            auto* faction = entityManager.getComponent<Components::FactionComponent>(id);
+            if (!faction || faction->faction == Components::Faction::NEUTRAL || gridCapacity.count(id) > 0) {
+                continue;
+            }
+            std::vector<EntityID> grid{id};
+            gridCapacity[id] = 0;
+            int capacity = 0;
+            int drones = 0;
+            for (size_t i = 0; i < grid.size(); ++i) {
+                if (auto* powerPlant = entityManager.getComponent<Components::PowerPlantComponent>(grid[i])) {
+                    capacity += powerPlant->capacity;
+                }
+                if (auto* garisson = entityManager.getComponent<Components::GarissonComponent>(grid[i])) {
+                    drones += static_cast<int>(garisson->getDroneCount());
+                }
+                for (EntityID other : powerGrid.getLinks(grid[i])) {
+                    auto* otherFaction = entityManager.getComponent<Components::FactionComponent>(other);
+                    if (otherFaction && otherFaction->faction == faction->faction && gridCapacity.count(other) == 0) {
+                        gridCapacity[other] = 0;
+                        grid.push_back(other);
+                    }
+                }
+            }
+            for (EntityID member : grid) {
+                gridCapacity[member] = capacity;
+                if (powerGrid.getCapacity(member) != capacity) {
+                    log_err << "Power grid capacity of structure " << member << " is " << powerGrid.getCapacity(member) << ", scan found " << capacity;
+                }
+                if (powerGrid.getDrones(member) != drones) {
+                    log_err << "Power grid drones of structure " << member << " are " << powerGrid.getDrones(member) << ", scan found " << drones;
+                }
+            }
         }
     }
+#endif
+
+    // Run the debug cross-check every 5 seconds on the world timer wheel
+    void ScheduleGameStateSystem(Game::GameEntityManager& entityManager) {
+#ifndef NDEBUG
+        float interval = 5.f;
+        entityManager.getTimers().schedulePeriodic(entityManager.getTime() + interval, interval, [&entityManager, interval](double time) {
+            GameStateSystem(entityManager, interval);
+        });
+#endif
+    }
 }
 
-#endif // WINNING_CONDITIONS_SYSTEM_HPP
\ No newline at end of file
+#endif // WINNING_CONDITIONS_SYSTEM_HPP
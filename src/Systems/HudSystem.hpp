@@ -5,19 +5,25 @@
 #include <format>
 #include <TGUI/TGUI.hpp>
 #include <cstdio>
+#include <cmath>
 
 #include "Core/Entity.hpp"
 #include "Components/HoverComponent.hpp"
 #include "Components/TagComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/LaunchComponent.hpp"
 #include "Components/FactionComponent.hpp"
+#include "Components/SelectableComponent.hpp"
+
+#include "Game/SimulationClock.hpp"
+#include "Game/Simulation.hpp"
 
 #include "Config.hpp"
 #include <TGUI/TGUI.hpp>
 #include <TGUI/Backend/SFML-Graphics.hpp>
 
 namespace Systems {
-    void HudSystem(Game::GameEntityManager& entityManager, tgui::Gui& gui) {
+    void HudSystem(Game::GameEntityManager& entityManager, tgui::Gui& gui, const Game::SimulationClock& simulationClock, const Game::Simulation& simulation) {
         static tgui::Theme::Ptr theme = Resource::ResourceManager::getInstance().getTheme(Resource::Paths::DARK_THEME);
 
         // GUI widgets declarations
@@ -28,6 +34,7 @@ namespace Systems {
         // Top screen labels
         static tgui::Label::Ptr player1Label = nullptr;
         static tgui::Label::Ptr player2Label = nullptr;
+        static tgui::Label::Ptr speedLabel = nullptr;
         
         // Panels Init
         if (!infoPanel) {
@@ -38,7 +45,10 @@ namespace Systems {
         }
 
         if(!topPanel) {
-            topPanel = tgui::Panel::create({"100%", "100"}); // Full width, fixed height
+            // Full width, tall enough to list every opponent
+            unsigned int opponents = entityManager.getGameState() ? entityManager.getGameState()->playerCount - 1 : 1;
+            float height = std::max(100.f, opponents * (Config::GUI_TEXT_SIZE + 6.f) + 10.f);
+            topPanel = tgui::Panel::create({"100%", tgui::String::fromNumber(height)});
             topPanel->setRenderer(theme->getRenderer("Panel"));
             gui.add(topPanel);
 
@@ -59,6 +69,13 @@ namespace Systems {
             player2Label->setPosition({"50%", "0"}); // Start at the middle of the panel
             topPanel->add(player2Label);
 
+            // Add Simulation Speed Label
+            speedLabel = tgui::Label::create();
+            speedLabel->setRenderer(theme->getRenderer("Label"));
+            speedLabel->setTextSize(Config::GUI_TEXT_SIZE);
+            speedLabel->setPosition({"30%", "10"});
+            topPanel->add(speedLabel);
+
             // Add AI Difficulty Label
             auto difficultyLabel = tgui::Label::create("AI Difficulty:");
             difficultyLabel->setRenderer(theme->getRenderer("Label"));
@@ -110,54 +127,87 @@ namespace Systems {
 
         }
 
+        // Simulation speed, selected and actually reached, and the rewind history
+        {
+            char buffer[200];
+            int length = 0;
+            if (simulationClock.isPaused()) {
+                length = std::snprintf(buffer, sizeof(buffer), "Speed: paused\n");
+            } else {
+                length = std::snprintf(buffer, sizeof(buffer), "Speed: %.0fx\nAchieved: %.1fx%s\n",
+                    simulationClock.getTimeScale(),
+                    simulationClock.getAchievedScale(),
+                    simulationClock.isDegraded() ? " [degraded]" : "");
+            }
+            if (simulation.getHistoryLength() > 0.f) {
+                length += std::snprintf(buffer + length, sizeof(buffer) - length, "History: %.0f s, %.0f KB/min\n",
+                    simulation.getHistoryLength(),
+                    simulation.getHistoryBytesPerMinute() / 1024.f);
+            }
+            const auto& dronePool = entityManager.getDronePool();
+            std::snprintf(buffer + length, sizeof(buffer) - length, "Drone pool: %zu kept, %.0f%% reused",
+                dronePool.size(),
+                dronePool.getStatistics().getHitRate() * 100.f);
+            speedLabel->setText(buffer);
+        }
+
         // Top Panel display logic
-        auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
+        auto* gameState = entityManager.getGameState();
         if (gameState)
         {
-            auto totalPlayers = gameState->playerDrones.size();
+            auto totalPlayers = gameState->playerCount;
 
             if(totalPlayers == 0){
                 throw std::runtime_error("No players found");
             }
 
-            if (totalPlayers > 0)
+            // The local player on the left, every opponent on the right
             {
                 std::stringstream ss;
-                ss << "Player 1";
-                ss << "\nDrones: " << gameState->playerDrones[Components::Faction::PLAYER_1];
-                auto playerDrones = gameState->playerDrones[Components::Faction::PLAYER_1];
+                ss << Components::getFactionStyle(Components::Faction::PLAYER_1).name;
+                auto playerDrones = gameState->getDroneCount(Components::Faction::PLAYER_1);
+                ss << "\nDrones: " << playerDrones;
                 auto playerEnergy = gameState->playerEnergy[Components::Faction::PLAYER_1];
 
                 if(playerEnergy <= playerDrones){
                     ss << " [production blocked]";
                 }
 
-                ss << "\nEnergy: " << gameState->playerEnergy[Components::Faction::PLAYER_1];
+                ss << "\nEnergy: " << playerEnergy;
                 player1Label->setText(ss.str());
             }
 
             if(totalPlayers > 1){
                 std::stringstream ss;
-                ss << "Player 2";
-                auto playerDrones = gameState->playerDrones[Components::Faction::PLAYER_2];
-                auto playerEnergy = gameState->playerEnergy[Components::Faction::PLAYER_2];
-
-                ss << "\n";
-                if(playerEnergy <= playerDrones){
-                    ss << " [production blocked] ";
+                for (unsigned int player = 2; player <= totalPlayers; ++player) {
+                    auto faction = Components::getPlayerFaction(player);
+                    auto playerDrones = gameState->getDroneCount(faction);
+                    auto playerEnergy = gameState->playerEnergy[faction];
+
+                    ss << Components::getFactionStyle(faction).name << ": ";
+                    if (!gameState->isAlive(faction)) {
+                        ss << "out";
+                    } else if (Config::ENABLE_FOG_OF_WAR) {
+                        // Opponents' forces are not known under the fog of war
+                        ss << "in play";
+                    } else {
+                        if(playerEnergy <= playerDrones){
+                            ss << "[production blocked] ";
+                        }
+                        ss << "Drones: " << playerDrones << ", Energy: " << playerEnergy;
+                    }
+                    if (player < totalPlayers) {
+                        ss << "\n";
+                    }
                 }
-                ss << "Drones: " << gameState->playerDrones[Components::Faction::PLAYER_2];
-
-
-                ss << "\nEnergy: " << gameState->playerEnergy[Components::Faction::PLAYER_2];
                 player2Label->setText(ss.str());
             }
         }
         
         // Hover Panel display logic
         bool entityHovered = false;
-        auto& entities = entityManager.getAllEntities();
-        for (auto& [id, entity] : entities) {
+        for (EntityID id : entityManager.getPicking().getHovered()) {
+            Entity& entity = entityManager.getEntity(id);
 
             auto* hoverComp = entity.getComponent<Components::HoverComponent>();
             auto* tagComponent = entity.getComponent<Components::TagComponent>();
@@ -173,6 +223,15 @@ namespace Systems {
                 auto* garissonComp = entity.getComponent<Components::GarissonComponent>();
                 auto* shieldComp = entity.getComponent<Components::ShieldComponent>();
 
+                // Only the name of structures under the fog of war is known
+                auto* factionComp = entity.getComponent<Components::FactionComponent>();
+                auto* transformComp = entity.getComponent<Components::TransformComponent>();
+                if (Config::ENABLE_FOG_OF_WAR && transformComp && !(factionComp && factionComp->faction == Components::LOCAL_PLAYER)
+                    && !entityManager.getVisibility().isVisible(Components::LOCAL_PLAYER, transformComp->getPosition())) {
+                    garissonComp = nullptr;
+                    shieldComp = nullptr;
+                }
+
                 std::stringstream ss;
 
                 if (factoryComp) {
@@ -189,6 +248,11 @@ namespace Systems {
                         productionRate
                     );
                     ss << buffer;
+
+                    // Only the plants on the factory's power grid count towards its production
+                    if (factionComp && factionComp->faction == Components::LOCAL_PLAYER) {
+                        ss << "\nGrid capacity: " << entityManager.getPowerGrid().getCapacity(id);
+                    }
                 }
 
                 if (powerPlantComp) {
@@ -197,6 +261,17 @@ namespace Systems {
 
                 if(garissonComp){
                     ss << "\nDrones stationed: " << garissonComp->getDroneCount();
+                    if (auto* launch = entity.getComponent<Components::LaunchComponent>()) {
+                        ss << "\nLaunching: " << launch->remaining << " to go";
+                    }
+                    // Own forces around the structure, the opponents' are hidden by the fog of war
+                    if (factionComp && factionComp->faction == Components::LOCAL_PLAYER && transformComp) {
+                        auto nearby = entityManager.getRegions().query(transformComp->getPosition(), Config::STRENGTH_RADIUS,
+                                                                       Game::RegionTree::getMask(Components::LOCAL_PLAYER), entityManager.getTime());
+                        char buffer[100];
+                        std::snprintf(buffer, sizeof(buffer), "\nNearby: %u drones, %.0f shield", nearby.getDrones(), nearby.shield);
+                        ss << buffer;
+                    }
                 }
 
                 if(shieldComp){
@@ -206,13 +281,30 @@ namespace Systems {
                         buffer, 
                         sizeof(buffer), 
                         "\nShield: %.1f/%.1f\nShield Regen: %.1f/s", 
-                        shieldComp->currentShield, 
+                        shieldComp->getShield(entityManager.getTime()), 
                         shieldComp->maxShield, 
                         shieldComp->regenRate
                     );
                     ss << buffer;
                 }
 
+                // Flight time from the selected structure, the drones an attack from there would take
+                EntityID selectedID = 0;
+                entityManager.getPicking().forEach(Game::PickingGrid::SELECTABLE, [&](EntityID candidate) {
+                    auto* selectable = entityManager.getComponent<Components::SelectableComponent>(candidate);
+                    if (selectable && selectable->isSelected) {
+                        selectedID = candidate;
+                    }
+                });
+                if (selectedID != 0 && selectedID != id) {
+                    float travelTime = entityManager.getDistances().getTravelTime(selectedID, id);
+                    if (std::isfinite(travelTime)) {
+                        char buffer[100];
+                        std::snprintf(buffer, sizeof(buffer), "\nFlight from selected: %.1f s", travelTime);
+                        ss << buffer;
+                    }
+                }
+
                 auto label = tgui::Label::create(ss.str());
                 label->setRenderer(theme->getRenderer("Label"));
                 label->setTextSize(Config::GUI_TEXT_SIZE);
@@ -255,8 +347,8 @@ namespace Systems {
             if (gameState->winner == Components::Faction::PLAYER_1) {
                 gameOverLabel->setText("🎉 YOU WIN! 🎉");
                 gameOverLabel->getRenderer()->setTextColor(tgui::Color::Green);
-            } else if (gameState->winner == Components::Faction::PLAYER_2) {
-                gameOverLabel->setText("💀 YOU LOSE! 💀");
+            } else if (gameState->winner != Components::Faction::NEUTRAL) {
+                gameOverLabel->setText(std::string("💀 YOU LOSE! 💀\n") + Components::getFactionStyle(gameState->winner).name + " wins");
                 gameOverLabel->getRenderer()->setTextColor(tgui::Color::Red);
             } else {
                 gameOverLabel->setText("🏁 GAME OVER 🏁");
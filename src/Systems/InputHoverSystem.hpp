@@ -1,7 +1,7 @@
 #ifndef INPUT_HOVER_SYSTEM_HPP
 #define INPUT_HOVER_SYSTEM_HPP
 
-#include <unordered_map>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 #include "Core/Entity.hpp"
@@ -14,29 +14,29 @@
 #include "Game/GameEntityManager.hpp"
 
 namespace Systems {
+    // Only the entities under the mouse, found in the picking grid, and those hovered last frame are touched
     void InputHoverSystem(Game::GameEntityManager& entityManager, const sf::RenderWindow& window) {
         sf::Vector2i mousePos = sf::Mouse::getPosition(window);
         sf::Vector2f worldPos = window.mapPixelToCoords(mousePos);
 
-        auto& entities = entityManager.getAllEntities();
-        for (auto& [id, entity] : entities) {
-
-            auto* transform = entity.getComponent<Components::TransformComponent>();
-            auto* shapeComp = entity.getComponent<Components::ShapeComponent>();
-            auto* hoverComp = entity.getComponent<Components::HoverComponent>();
-
-            if (transform && shapeComp && hoverComp) {
-                // Check if mouse is within entity bounds
-                if (shapeComp->shape->getGlobalBounds().contains(worldPos)) {
-                    hoverComp->isHovered = true;
-                    // hoverComp->position = worldPos;
-                    hoverComp->position = static_cast<sf::Vector2f>(mousePos);
+        auto& picking = entityManager.getPicking();
+        for (EntityID id : picking.getHovered()) {
+            if (auto* hoverComp = entityManager.getComponent<Components::HoverComponent>(id)) {
+                hoverComp->isHovered = false;
+            }
+        }
 
-                } else {
-                    hoverComp->isHovered = false;
-                }
+        static std::vector<EntityID> hovered;
+        hovered.clear();
+        picking.pickAll(worldPos, Game::PickingGrid::HOVERABLE, hovered);
+        for (EntityID id : hovered) {
+            if (auto* hoverComp = entityManager.getComponent<Components::HoverComponent>(id)) {
+                hoverComp->isHovered = true;
+                // hoverComp->position = worldPos;
+                hoverComp->position = static_cast<sf::Vector2f>(mousePos);
             }
         }
+        picking.setHovered(hovered);
     }
 }
 
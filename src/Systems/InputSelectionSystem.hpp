@@ -7,12 +7,15 @@
 
 #include "Core/Entity.hpp"
 #include "Config.hpp"
-#include "Components/MoveComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/ShapeComponent.hpp"
 #include "Components/SelectableComponent.hpp"
-#include "Components/AttackOrderComponent.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Components/GarissonComponent.hpp"
 #include "Components/DroneTransferComponent.hpp"
 
-#include "Game/Builder.hpp"
+#include "Game/GameEntityManager.hpp"
+#include "Game/Command.hpp"
 
 #include "Utils/Logger.hpp"
 
@@ -20,37 +23,27 @@ namespace Systems {
 
     EntityID getPreviouslySelectedEntity(Game::GameEntityManager& entityManager){
 
-        auto& entities = entityManager.getAllEntities();
-        for (auto& [id, entity] : entities) {
-            auto* selectableComp = entity.getComponent<Components::SelectableComponent>();
+        // Only selectable entities are in the picking grid, drones are not visited
+        EntityID selected = -1;
+        entityManager.getPicking().forEach(Game::PickingGrid::SELECTABLE, [&](EntityID id) {
+            auto* selectableComp = entityManager.getComponent<Components::SelectableComponent>(id);
             if (selectableComp && selectableComp->isSelected) {
-                return id;
+                selected = id;
             }
-        }
-        return -1;
+        });
+        return selected;
     }
 
     EntityID getSelectedEntity(const sf::Event& event, Game::GameEntityManager& entityManager, const sf::RenderWindow& window){
         sf::Vector2f worldPos = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
 
-        auto& entities = entityManager.getAllEntities();
-        // Determine if a new selection was made
-        for (auto& [targetID, targetEntity] : entities) {
-            auto* targetTransform = targetEntity.getComponent<Components::TransformComponent>();
-            auto* targetShapeComp = targetEntity.getComponent<Components::ShapeComponent>();
-            auto* targetSelectableComp = targetEntity.getComponent<Components::SelectableComponent>();
-
-            if (targetTransform && targetShapeComp && targetSelectableComp) {
-                    // Check if mouse is within entity bounds (eg. click on entity)
-                if (targetShapeComp->shape->getGlobalBounds().contains(worldPos)){
-                    return targetID;
-                }
-            }
-        }
-        return -1;
+        // Check if mouse is within entity bounds (eg. click on entity)
+        EntityID targetID = entityManager.getPicking().pick(worldPos, Game::PickingGrid::SELECTABLE);
+        return targetID != 0 ? targetID : -1;
     }
 
-    void InputSelectionSystem(const sf::Event& event, Game::GameEntityManager& entityManager, const sf::RenderWindow& window) {
+    // Selection is handled here, orders are handed to the simulation as commands
+    void InputSelectionSystem(const sf::Event& event, Game::GameEntityManager& entityManager, const sf::RenderWindow& window, std::vector<Game::Command>& commands) {
 
         if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
             // Get the click position in world coordinates
@@ -73,7 +66,7 @@ namespace Systems {
                 Entity& originEntity = entityManager.getEntity(previouslySelectedEntityID);
                 auto* factionComp = originEntity.getComponent<Components::FactionComponent>();
                 if(factionComp->faction == Components::Faction::PLAYER_1){
-                    entityManager.addComponent(previouslySelectedEntityID, Components::AttackOrderComponent{previouslySelectedEntityID, selectedEntityID});
+                    commands.push_back({Game::Command::Type::ATTACK, previouslySelectedEntityID, selectedEntityID, factionComp->faction});
                 }               
                 // deselect targets after attack order
                 entityManager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
@@ -102,8 +95,9 @@ namespace Systems {
                 // No new target is selected now
                 // Cancel old selection and orders
                 auto* transferComp = entityManager.getComponent<Components::DroneTransferComponent>(previouslySelectedEntityID);
-                if(transferComp){
-                    entityManager.removeComponent<Components::DroneTransferComponent>(previouslySelectedEntityID);
+                auto* factionComp = entityManager.getComponent<Components::FactionComponent>(previouslySelectedEntityID);
+                if(transferComp && factionComp){
+                    commands.push_back({Game::Command::Type::CANCEL_TRANSFER, previouslySelectedEntityID, 0, factionComp->faction});
                 }
                 // deselect
                 entityManager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
@@ -121,7 +115,7 @@ namespace Systems {
                     auto* factionComp = entityManager.getEntity(previouslySelectedEntityID).getComponent<Components::FactionComponent>();
 
                     if(factionComp->faction == Components::Faction::PLAYER_1){
-                        entityManager.addComponent(previouslySelectedEntityID, Components::DroneTransferComponent(previouslySelectedEntityID, selectedEntityID, factionComp->faction));
+                        commands.push_back({Game::Command::Type::TRANSFER, previouslySelectedEntityID, selectedEntityID, factionComp->faction});
                     }
                 }
 
@@ -0,0 +1,127 @@
+#ifndef INTERCEPTION_SYSTEM_HPP
+#define INTERCEPTION_SYSTEM_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "Core/Entity.hpp"
+#include "Game/GameEntityManager.hpp"
+#include "Utils/SpatialHash.hpp"
+#include "Utils/Profiler.hpp"
+#include "Config.hpp"
+
+namespace Systems {
+
+    // Opposing drones that touch in flight destroy each other.
+    // Every flight is swept from the previous tick to this one. A grid over the end positions pairs up drones that
+    // could have met, and a continuous test on their relative motion finds when they came within the contact radius,
+    // so drones cannot pass through each other between two ticks.
+    // Contacts are resolved in time order, a drone is destroyed at most once.
+    // The search runs per map tile on the worker threads, each tile writing its own contact list. The lists are merged
+    // and sorted on the full (time, first, second) key, so the outcome is the same for any number of threads.
+    void InterceptionSystem(Game::GameEntityManager& entityManager, float dt) {
+        using Contact = Game::InterceptionBuffers::Contact;
+        auto& buffers = entityManager.getInterceptionBuffers();
+        auto& hash = buffers.hash;
+        auto& contacts = buffers.contacts;
+        auto& tileContacts = buffers.tileContacts;
+        auto& destroyed = buffers.destroyed;
+        auto& resolved = buffers.resolved;
+
+        auto& flights = entityManager.getFlights();
+        auto& tiles = entityManager.getTiles();
+        auto& workers = entityManager.getWorkers();
+        size_t count = flights.size();
+        double now = entityManager.getTime();
+        flights.sweep(now - dt, now, &workers);
+        // Drones changed tiles during the tick, landed or were destroyed, hand them over before the tiles are searched
+        tiles.exchange(flights, workers);
+        if (count < 2) {
+            return;
+        }
+        const float* endX = flights.getPositionsX();
+        const float* endY = flights.getPositionsY();
+
+        // Two drones that touched during the tick end at most the radius plus both travels apart
+        float travel = 0.f; // Squared
+        for (size_t i = 0; i < count; ++i) {
+            sf::Vector2f start = flights.getSweepStart(i);
+            float moveX = endX[i] - start.x;
+            float moveY = endY[i] - start.y;
+            travel = std::max(travel, moveX * moveX + moveY * moveY);
+        }
+        float radius = Config::INTERCEPT_RADIUS;
+        hash.build(endX, endY, count, radius + 2.f * std::sqrt(travel));
+
+        tileContacts.resize(tiles.getTileCount());
+        workers.run(tiles.getTileCount(), [&](size_t tile) {
+            // Summed over the worker threads
+            Utils::ProfileZone zone("Contacts");
+            auto& found = tileContacts[tile];
+            found.clear();
+            for (EntityID droneID : tiles.getDrones(tile)) {
+                size_t i = flights.getSlot(droneID);
+                std::uint32_t faction = flights.getFaction(i);
+                sf::Vector2f startI = flights.getSweepStart(i);
+                hash.forEachNear(endX[i], endY[i], [&](std::uint32_t j) {
+                    if (j <= i || flights.getFaction(j) == faction) {
+                        return;
+                    }
+                    // Closest approach of the relative motion over the tick, |d + v s| = radius for s in [0, 1]
+                    sf::Vector2f startJ = flights.getSweepStart(j);
+                    float dx = startI.x - startJ.x;
+                    float dy = startI.y - startJ.y;
+                    float vx = (endX[i] - startI.x) - (endX[j] - startJ.x);
+                    float vy = (endY[i] - startI.y) - (endY[j] - startJ.y);
+                    float c = dx * dx + dy * dy - radius * radius;
+                    float s = 0.f;
+                    if (c > 0.f) {
+                        float a = vx * vx + vy * vy;
+                        float b = dx * vx + dy * vy;
+                        float discriminant = b * b - a * c;
+                        if (a <= 0.f || b >= 0.f || discriminant < 0.f) {
+                            return;
+                        }
+                        s = (-b - std::sqrt(discriminant)) / a;
+                        if (s > 1.f) {
+                            return;
+                        }
+                    }
+                    EntityID first = flights.getDrone(i);
+                    EntityID second = flights.getDrone(j);
+                    found.push_back({s * dt, std::min(first, second), std::max(first, second)});
+                });
+            }
+        });
+
+        contacts.clear();
+        for (auto& found : tileContacts) {
+            contacts.insert(contacts.end(), found.begin(), found.end());
+        }
+        if (contacts.empty()) {
+            return;
+        }
+
+        std::sort(contacts.begin(), contacts.end(), [](const Contact& a, const Contact& b) {
+            if (a.time != b.time) return a.time < b.time;
+            if (a.first != b.first) return a.first < b.first;
+            return a.second < b.second;
+        });
+
+        destroyed.clear();
+        resolved.clear();
+        for (auto& contact : contacts) {
+            if (resolved.count(contact.first) == 0 && resolved.count(contact.second) == 0) {
+                resolved.insert(contact.first);
+                resolved.insert(contact.second);
+                destroyed.push_back(contact.first);
+                destroyed.push_back(contact.second);
+            }
+        }
+        // Their arrivals are skipped once the drones are gone, the faction counters drop with the removal
+        entityManager.removeEntities(destroyed);
+    }
+}
+
+#endif // INTERCEPTION_SYSTEM_HPP
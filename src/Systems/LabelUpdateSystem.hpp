@@ -9,6 +9,7 @@
 #include "Components/LabelComponent.hpp"
 #include "Components/ShieldComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/MoveComponent.hpp"
 
 #include "Game/GameEntityManager.hpp"
 
@@ -19,6 +20,11 @@ namespace Systems {
             auto* transform = entity.getComponent<Components::TransformComponent>();
             auto* labelComp = entity.getComponent<Components::LabelComponent>();
 
+            // Flight labels are positioned lazily by the MovementSystem
+            if (entity.hasComponent<Components::MoveComponent>()) {
+                continue;
+            }
+
             if (labelComp && transform) {
                 // Update the text position based on parent position + offset
                 labelComp->text.setPosition(transform->getPosition() + labelComp->offset);
@@ -59,7 +65,7 @@ namespace Systems {
 
                 // auto* shield = entity.getComponent<Components::ShieldComponent>();
                 // if(shield){
-                //     ss << "\nShield: " << shield->getShield() << "/" << shield->maxShield;
+                //     ss << "\nShield: " << shield->getShield(entityManager.getTime()) << "/" << shield->maxShield;
                 // }
                 labelComp->text.setString(ss.str());
             }
@@ -7,54 +7,66 @@
 #include "Core/Entity.hpp"
 #include "Components/TransformComponent.hpp"
 #include "Components/MoveComponent.hpp"
+#include "Components/LabelComponent.hpp"
 #include "Config.hpp"
 #include "Utils/Logger.hpp"
 
+#include "Systems/VisibilitySystem.hpp"
+
 namespace Systems {
-    void MovementSystem(Game::GameEntityManager& entityManager, float dt) {
+    // Flights are closed-form functions of time, only the cosmetic flocking offsets are integrated per frame.
+    // Right before rendering, the flight table is evaluated in one vectorised pass, fleets spread apart on top of it,
+    // and only drones inside the camera view (or just leaving it) and seen by the local player are written back.
+    void MovementSystem(Game::GameEntityManager& entityManager, const sf::View& view) {
+
+        double now = entityManager.getTime();
+
+        // Cull with a margin so drones entering the screen, or flocking off their path, are not clipped
+        float margin = Config::DRONE_LENGTH * 2.f + Config::FLOCK_MAX_OFFSET;
+        sf::FloatRect visibleArea(
+            view.getCenter() - view.getSize() / 2.f - sf::Vector2f(margin, margin),
+            view.getSize() + sf::Vector2f(2.f * margin, 2.f * margin)
+        );
+
+        auto& flights = entityManager.getFlights();
+        auto& workers = entityManager.getWorkers();
+        flights.evaluate(now, visibleArea, &workers);
+        flights.flock(now, &workers);
+        Systems::VisibilitySystem(entityManager);
+
+        auto& fog = entityManager.getVisibility();
+        auto localPlayer = static_cast<std::uint32_t>(Components::LOCAL_PLAYER);
 
-        auto& entities = entityManager.getAllEntities();
-        for (auto& [id, entity] : entities) {
+        for (size_t slot = 0; slot < flights.size(); ++slot) {
+            bool visible = flights.isVisible(slot);
+            if (visible && Config::ENABLE_FOG_OF_WAR && flights.getFaction(slot) != localPlayer) {
+                visible = fog.isVisible(Components::LOCAL_PLAYER, flights.getPosition(slot));
+            }
+            if (!visible && !flights.wasOnScreen(slot)) {
+                continue;
+            }
+            flights.setOnScreen(slot, visible);
+
+            Entity& entity = entityManager.getEntity(flights.getDrone(slot));
             auto* transform = entity.getComponent<Components::TransformComponent>();
             auto* move = entity.getComponent<Components::MoveComponent>();
-            auto* tag = entity.getComponent<Components::TagComponent>();
 
             if (transform && move) {
-                // Handle movement towards target
-                if (move->moveToTarget) {
-                    sf::Vector2f direction = move->targetPosition - transform->getPosition();
-                    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-                    float stoppingDistance = std::max(5.0f, move->speed * 0.1f); // 10% of speed, min 5 pixels
-                    if (distance > stoppingDistance) { // Stop if close enough
-
-                        direction /= distance; // Normalize direction vector
-
-                        // Move towards the target
-                        float step = move->speed * dt;
-
-                        // Prevent overshooting by clamping step
-                        if (step >= distance) {
-                            transform->transform.setPosition(move->targetPosition);
-                            move->moveToTarget = false; // Stop movement
-                        } else {
-                            sf::Vector2f newPosition = transform->getPosition() + direction * step;
-                            transform->transform.setPosition(newPosition);
-
-                            // Rotate towards target
-                            float angle = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG;
-                            transform->transform.setRotation(angle + 90.f); // Align triangle tip
-                        }
-                    } else {
-                        // Snap to target when very close
-                        transform->transform.setPosition(move->targetPosition);
-                        move->moveToTarget = false; // Stop movement
-                    }
+                move->isOnScreen = visible;
+                if (!visible) {
+                    continue;
                 }
 
-                // Handle angular rotation
-                float newRotation = transform->getRotation() + move->angularVelocity * dt;
-                transform->transform.setRotation(newRotation);
+                sf::Vector2f position = flights.getDisplayPosition(slot);
+                transform->transform.setPosition(position);
+                transform->transform.setRotation(move->getRotation(now));
+
+                // Flight labels follow the drone here rather than in the LabelUpdateSystem
+                auto* labelComp = entity.getComponent<Components::LabelComponent>();
+                if (labelComp) {
+                    labelComp->text.setPosition(position + labelComp->offset);
+                    labelComp->text2.setPosition(position);
+                }
             }
         }
     }
@@ -63,4 +75,4 @@ namespace Systems {
 
 
 
-#endif // MOVEMENT_SYSTEM_HPP
\ No newline at end of file
+#endif // MOVEMENT_SYSTEM_HPP
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <sstream>
+#include <cstdint>
 #include "Core/Entity.hpp"
 
 #include "Components/FactoryComponent.hpp"
@@ -13,54 +14,55 @@
 
 namespace Systems {
 
-    void ProductionSystem(Game::GameEntityManager& entityManager, float dt) {
+    // Called by the factory production timer once per production cycle
+    void ProduceDrone(Game::GameEntityManager& entityManager, EntityID factoryID) {
+        auto* faction = entityManager.getComponent<Components::FactionComponent>(factoryID);
+        auto* garisson = entityManager.getComponent<Components::GarissonComponent>(factoryID);
 
-        auto& entities = entityManager.getAllEntities();
-        auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
-
-        // Update all energy totals
-        gameState->ClearAllEnergy();
-        for(auto& [id, entity] : entities){
-            auto* powerPlant = entity.getComponent<Components::PowerPlantComponent>();
-            auto* faction = entity.getComponent<Components::FactionComponent>();
-            
-            if(powerPlant && faction){
-                gameState->playerEnergy[faction->faction] += powerPlant->capacity; 
-            }
+        if (!garisson || !faction || faction->faction == Components::Faction::NEUTRAL) {
+            return;
         }
 
-        // Update all drone production
-        for (auto& [id, entity] : entities) {
-
-            auto* factory = entity.getComponent<Components::FactoryComponent>();
-            auto* faction = entity.getComponent<Components::FactionComponent>();
-            auto* garisson = entity.getComponent<Components::GarissonComponent>(); 
+        // If the power grid of the factory supplies less energy than it has drones to support, do not generate new drones.
+        // A grid supports the drones parked in it and a share of the owner's drones in flight, by its part of the energy.
+        auto* gameState = entityManager.getGameState();
+        auto& powerGrid = entityManager.getPowerGrid();
+        int capacity = powerGrid.getCapacity(factoryID);
+        int energy = gameState->playerEnergy[faction->faction];
+        std::int64_t drones = powerGrid.getDrones(factoryID);
+        if (energy > 0) {
+            drones += static_cast<std::int64_t>(gameState->inFlightDrones[faction->faction]) * capacity / energy;
+        }
+        if(capacity <= drones){
+            return;
+        }
 
-            // Generate drones in factories
-            if (factory && garisson && faction && faction->faction != Components::Faction::NEUTRAL) {
-                // Accumulate production based on productionRate and dt
-                factory->productionTimer += factory->droneProductionRate * dt;
+        // Add one drone to player
+        entityManager.addGarrisonDrones(factoryID, 1);
+    }
 
-                // Timer still ongoing, skip
-                if(factory->productionTimer < 1.f){
-                    continue;
-                }
+    // Start the production cycle of a factory that has an owner, the first drone is due at firstTime
+    // (one period from now when negative). The timer keeps running across captures, it produces for whoever owns the factory.
+    void ScheduleProduction(Game::GameEntityManager& entityManager, EntityID factoryID, double firstTime = -1.0) {
+        auto* factory = entityManager.getComponent<Components::FactoryComponent>(factoryID);
+        auto* faction = entityManager.getComponent<Components::FactionComponent>(factoryID);
+        auto& timers = entityManager.getTimers();
 
-                // Reset timer after full cycle
-                factory->productionTimer -= 1.f;
+        if (!factory || !faction || faction->faction == Components::Faction::NEUTRAL || factory->droneProductionRate <= 0.f) {
+            return;
+        }
+        if (timers.isScheduled(factory->productionTimerID)) {
+            return;
+        }
 
-                // If less energy than drones, do not generate new drones
-                auto* gameState = entityManager.getGameStateEntity().getComponent<Components::GameStateComponent>();
-                if(gameState->playerEnergy[faction->faction] <= gameState->playerDrones[faction->faction]){
-                    continue;
-                }
-                
-                // Add one drone to player
-                garisson->incrementDroneCount();
-                gameState->playerDrones[faction->faction]++;
-            }
+        float period = 1.f / factory->droneProductionRate;
+        if (firstTime < 0.0) {
+            firstTime = entityManager.getTime() + period;
         }
+        factory->productionTimerID = timers.schedulePeriodic(firstTime, period, [&entityManager, factoryID](double time) {
+            ProduceDrone(entityManager, factoryID);
+        });
     }
 }
 
-#endif // PRODUCTION_SYSTEM_HPP
\ No newline at end of file
+#endif // PRODUCTION_SYSTEM_HPP
@@ -0,0 +1,109 @@
+#ifndef PROFILER_OVERLAY_SYSTEM_HPP
+#define PROFILER_OVERLAY_SYSTEM_HPP
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <TGUI/TGUI.hpp>
+#include <TGUI/Backend/SFML-Graphics.hpp>
+
+#include "Game/GameEntityManager.hpp"
+#include "Resources/ResourceManager.hpp"
+#include "Utils/Profiler.hpp"
+#include "Config.hpp"
+
+namespace Systems {
+
+    // Where the frames go: per-zone ms over the last frames, entity counts and a frame time graph.
+    // Shown while the profiler records, the text and graph are refreshed every PROFILER_REFRESH_FRAMES frames.
+    void ProfilerOverlaySystem(Game::GameEntityManager& entityManager, tgui::Gui& gui) {
+        static tgui::Theme::Ptr theme = Resource::ResourceManager::getInstance().getTheme(Resource::Paths::DARK_THEME);
+
+        static tgui::Panel::Ptr panel = nullptr;
+        static tgui::Label::Ptr label = nullptr;
+        static tgui::CanvasSFML::Ptr graph = nullptr;
+        static unsigned int framesSinceRefresh = 0;
+
+        const float graphWidth = 400.f;
+        const float graphHeight = 80.f;
+
+        if (!panel) {
+            panel = tgui::Panel::create({"440", "620"});
+            panel->setRenderer(theme->getRenderer("Panel"));
+            panel->setPosition({"100% - 450", "120"});
+            panel->setVisible(false);
+            gui.add(panel);
+
+            label = tgui::Label::create();
+            label->setRenderer(theme->getRenderer("Label"));
+            label->setTextSize(Config::GUI_TEXT_SIZE - 4);
+            label->setPosition({"10", "10"});
+            panel->add(label);
+
+            graph = tgui::CanvasSFML::create({graphWidth, graphHeight});
+            graph->setPosition({"20", "100% - 90"});
+            panel->add(graph);
+        }
+
+        auto& profiler = Utils::Profiler::getInstance();
+        panel->setVisible(profiler.isEnabled());
+        if (!profiler.isEnabled() || ++framesSinceRefresh < Config::PROFILER_REFRESH_FRAMES) {
+            return;
+        }
+        framesSinceRefresh = 0;
+
+        // Per-zone statistics, nested zones indented under the zone they run in
+        static std::vector<Utils::Profiler::ZoneStats> zones;
+        profiler.getStats(zones);
+        auto frame = profiler.getFrameStats();
+
+        std::string text;
+        char line[160];
+        std::snprintf(line, sizeof(line), "Last %zu frames, ms        avg     p95     max\n", profiler.getFrameCount());
+        text += line;
+        std::snprintf(line, sizeof(line), "%-22s %7.2f %7.2f %7.2f\n", "Frame", frame.average, frame.p95, frame.max);
+        text += line;
+        for (auto& zone : zones) {
+            std::string name = std::string(2 * (zone.depth + 1), ' ') + zone.name;
+            std::snprintf(line, sizeof(line), "%-22s %7.2f %7.2f %7.2f\n", name.c_str(), zone.average, zone.p95, zone.max);
+            text += line;
+        }
+
+        std::snprintf(line, sizeof(line), "\nEntities: %zu\nStructures: %zu, drones in flight: %zu\nAI players: %zu, threads: %u",
+                      entityManager.getAllEntities().size(),
+                      entityManager.getGarissons().size(),
+                      entityManager.getFlights().size(),
+                      entityManager.getAIEntities().size(),
+                      entityManager.getWorkers().getThreadCount());
+        text += line;
+        if (auto dropped = profiler.getDroppedSamples()) {
+            std::snprintf(line, sizeof(line), "\nZones dropped: %llu", static_cast<unsigned long long>(dropped));
+            text += line;
+        }
+        label->setText(text);
+
+        // Frame times, oldest on the left, scaled to at least two 60 fps frames with the 60 fps line drawn
+        static std::vector<float> frameTimes;
+        profiler.getFrameTimes(frameTimes);
+        float scale = std::max(2000.f / 60.f, frame.max);
+        auto toY = [&](float ms) { return graphHeight - std::min(ms / scale, 1.f) * graphHeight; };
+
+        sf::VertexArray target(sf::Lines);
+        target.append(sf::Vertex({0.f, toY(1000.f / 60.f)}, sf::Color(80, 160, 80)));
+        target.append(sf::Vertex({graphWidth, toY(1000.f / 60.f)}, sf::Color(80, 160, 80)));
+
+        sf::VertexArray curve(sf::LineStrip);
+        float step = graphWidth / std::max<size_t>(Config::PROFILER_FRAMES - 1, 1);
+        for (size_t i = 0; i < frameTimes.size(); ++i) {
+            curve.append(sf::Vertex({i * step, toY(frameTimes[i])}, sf::Color::Yellow));
+        }
+
+        graph->clear(sf::Color(20, 20, 20, 200));
+        graph->draw(target);
+        graph->draw(curve);
+        graph->display();
+    }
+}
+
+#endif // PROFILER_OVERLAY_SYSTEM_HPP
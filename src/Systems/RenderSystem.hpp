@@ -14,6 +14,7 @@
 #include "Components/ShieldComponent.hpp"
 #include "Components/GarissonComponent.hpp"
 #include "Components/DroneTransferComponent.hpp"
+#include "Components/MoveComponent.hpp"
 
 #include "Utils/Graphics.hpp"
 
@@ -21,18 +22,46 @@ namespace Systems {
 
     void RenderSystem(Game::GameEntityManager& entityManager, sf::RenderWindow& window) {
         auto& entities = entityManager.getAllEntities();
-        
+
+        // Structures of other factions under the fog of war are drawn as unknown: neutral, no shield, orders or garrison
+        auto& fog = entityManager.getVisibility();
+        auto isHidden = [&fog](Entity& entity, const Components::TransformComponent* transform) {
+            auto* faction = entity.getComponent<Components::FactionComponent>();
+            if (!Config::ENABLE_FOG_OF_WAR || !transform || (faction && faction->faction == Components::LOCAL_PLAYER)) {
+                return false;
+            }
+            return !fog.isVisible(Components::LOCAL_PLAYER, transform->getPosition());
+        };
 
         // Layer 0
         // Background
 
         // Layer 1
+        // Hyperlanes
+        sf::VertexArray laneLines(sf::Lines);
+        sf::Color laneColor(255, 255, 255, 40);
+        entityManager.getHyperlanes().forEachLane([&laneLines, laneColor](sf::Vector2f from, sf::Vector2f to) {
+            laneLines.append(sf::Vertex(from, laneColor));
+            laneLines.append(sf::Vertex(to, laneColor));
+        });
+        window.draw(laneLines);
+
+        // Power grid links of the local player
+        sf::VertexArray gridLinks(sf::Lines);
+        sf::Color linkColor = Components::getFactionStyle(Components::LOCAL_PLAYER).color;
+        linkColor.a = 60;
+        entityManager.getPowerGrid().forEachLink(Components::LOCAL_PLAYER, [&gridLinks, linkColor](sf::Vector2f from, sf::Vector2f to) {
+            gridLinks.append(sf::Vertex(from, linkColor));
+            gridLinks.append(sf::Vertex(to, linkColor));
+        });
+        window.draw(gridLinks);
+
         for(auto& [id, entity] : entities) {
             auto* transform = entity.getComponent<Components::TransformComponent>();
 
             // Draw auto transfer orders (back plane)
             auto* transferOrder = entity.getComponent<Components::DroneTransferComponent>();
-            if (transferOrder) {
+            if (transferOrder && !isHidden(entity, transform)) {
                 auto* targetTransform = entityManager.getEntity(transferOrder->target).getComponent<Components::TransformComponent>();
                 sf::Color transparentWhite(255, 255, 255, 128); // 50% Transparent White 
                 // Render the dot at the pre-calculated position
@@ -47,6 +76,13 @@ namespace Systems {
             
             auto* transform = entity.getComponent<Components::TransformComponent>();
 
+            // Drones outside the view were not positioned by the MovementSystem
+            auto* move = entity.getComponent<Components::MoveComponent>();
+            if (move && !move->isOnScreen) {
+                continue;
+            }
+            bool hidden = !move && isHidden(entity, transform);
+
             // Draw shapes/sprites/shields
             // Draw selectable component
             auto* selectableComp = entity.getComponent<Components::SelectableComponent>();
@@ -60,7 +96,7 @@ namespace Systems {
 
             // Draw Shield
             auto* shield = entity.getComponent<Components::ShieldComponent>();
-            if (shield && transform) {
+            if (shield && transform && !hidden) {
                 sf::Vector2f center(transform->getPosition().x, transform->getPosition().y);
                 float baseRadius = 50.f;       // Base radius for the first circle
                 float radiusStep = 7.f;       // Space between concentric circles
@@ -68,7 +104,7 @@ namespace Systems {
                 int pointCount = 50;           // Smoothness of the arc
 
                 // Calculate full circles and remainder (using float logic for smooth rendering)
-                float shieldValue = shield->currentShield;
+                float shieldValue = shield->getShield(entityManager.getTime());
                 int fullCircles = static_cast<int>(shieldValue / 10.f); // Number of full circles
                 float remainder = std::fmod(shieldValue, 10.f);         // Remaining fractional shield value
 
@@ -125,36 +161,65 @@ namespace Systems {
                 shape->shape->setScale(transform->getScale());
 
                 auto* faction = entity.getComponent<Components::FactionComponent>();
-                if (faction) {
-                    if (faction->faction == Components::Faction::PLAYER_1) {
-                        shape->shape->setFillColor(sf::Color::Red);
-                    }else if(faction->faction == Components::Faction::PLAYER_2) {
-                        shape->shape->setFillColor(sf::Color::Blue);
-                    }else{
-                        // shape->shape->setFillColor(sf::Color::White);
-                    }
+                if (faction && (faction->faction != Components::Faction::NEUTRAL || hidden)) {
+                    shape->shape->setFillColor(Components::getFactionStyle(hidden ? Components::Faction::NEUTRAL : faction->faction).color);
                 }
                 window.draw(*shape->shape);
             }
         }
 
+        // Fog of war over the cells the local player does not see, one quad per run of hidden cells in a row
+        if (Config::ENABLE_FOG_OF_WAR) {
+            sf::VertexArray fogQuads(sf::Quads);
+            sf::Color fogColor(0, 0, 0, 150);
+            float cellSize = fog.getCellSize();
+            auto& visibleRows = fog.getVisibleRows(Components::LOCAL_PLAYER);
+            for (int row = 0; row < fog.getRows(); ++row) {
+                auto hiddenBits = ~visibleRows[row];
+                int column = 0;
+                while (column < Game::Visibility::COLUMNS) {
+                    if (!((hiddenBits >> column) & 1)) {
+                        column++;
+                        continue;
+                    }
+                    int first = column;
+                    while (column < Game::Visibility::COLUMNS && ((hiddenBits >> column) & 1)) {
+                        column++;
+                    }
+                    float top = row * cellSize;
+                    float left = first * cellSize;
+                    float right = column * cellSize;
+                    fogQuads.append(sf::Vertex({left, top}, fogColor));
+                    fogQuads.append(sf::Vertex({right, top}, fogColor));
+                    fogQuads.append(sf::Vertex({right, top + cellSize}, fogColor));
+                    fogQuads.append(sf::Vertex({left, top + cellSize}, fogColor));
+                }
+            }
+            window.draw(fogQuads);
+        }
+
         // Layer 3
         // Draw labels (non-gui)
         for (auto& [id, entity] : entities) {
 
-            // Draw non-gui text
+            // Draw non-gui text, the garrison of unknown structures stays hidden
             auto* textComp = entity.getComponent<Components::LabelComponent>();
-            if (textComp) {
+            auto* move = entity.getComponent<Components::MoveComponent>();
+            if (textComp && !(move && !move->isOnScreen)) {
                 window.draw(textComp->text);
-                window.draw(textComp->text2);
+                if (move || !isHidden(entity, entity.getComponent<Components::TransformComponent>())) {
+                    window.draw(textComp->text2);
+                }
             }
         }
 
         // Layer 4
         // 4. Draw Debug Symbols
-        Entity& aiEntity = entityManager.getAIEntity();
-        auto* aiComp = aiEntity.getComponent<Components::AIComponent>();
-        if (aiComp && aiComp && Config::ENABLE_DEBUG_SYMBOLS) { 
+        for (EntityID aiEntityID : entityManager.getAIEntities()) {
+            auto* aiComp = entityManager.getComponent<Components::AIComponent>(aiEntityID);
+            if (!aiComp || !Config::ENABLE_DEBUG_SYMBOLS) {
+                continue;
+            }
             for (auto& target : aiComp->debug.pinkDebugTargets) {
                 sf::CircleShape selectionShape(20.f);
                 selectionShape.setOrigin(10.f, 10.f);
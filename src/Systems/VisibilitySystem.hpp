@@ -0,0 +1,27 @@
+#ifndef VISIBILITY_SYSTEM_HPP
+#define VISIBILITY_SYSTEM_HPP
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/Visibility.hpp"
+
+namespace Systems {
+
+    // Move the vision of drones that crossed into another fog cell, then refresh the fog of the factions that changed.
+    // Reads the positions of the last flight table evaluation.
+    void VisibilitySystem(Game::GameEntityManager& entityManager) {
+        auto& flights = entityManager.getFlights();
+        auto& visibility = entityManager.getVisibility();
+
+        for (size_t slot = 0; slot < flights.size(); ++slot) {
+            auto cell = visibility.getCell(flights.getPosition(slot));
+            auto previous = flights.getVisionCell(slot);
+            if (cell != previous) {
+                visibility.moveDrone(static_cast<Components::Faction>(flights.getFaction(slot)), previous, cell);
+                flights.setVisionCell(slot, cell);
+            }
+        }
+        visibility.update();
+    }
+}
+
+#endif // VISIBILITY_SYSTEM_HPP
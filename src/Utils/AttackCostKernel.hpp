@@ -0,0 +1,75 @@
+#ifndef ATTACK_COST_KERNEL_HPP
+#define ATTACK_COST_KERNEL_HPP
+
+#include <cstddef>
+
+#include "Utils/Simd.hpp"
+
+// Batched attack costs over candidate (garrison, target) pairs, over structure-of-arrays data.
+// Every pair computes: cost = drones + shield + travelTime * regenRate
+// which is the drone count that takes the target once the shield regenerated during the flight.
+// Travel times come from the distance table, the target's values are gathered per pair by the caller.
+// All paths use the same operation order, so scalar and vector results are identical.
+
+namespace Utils::Kernels {
+
+    struct AttackCostBatch {
+        const float* travelTime;    // Flight time from the garrison to the target
+        const float* drones;
+        const float* shield;        // Current shield of the target
+        const float* regenRate;
+        size_t count;
+
+        float* cost;
+    };
+
+    inline void computeAttackCostsScalar(const AttackCostBatch& batch, size_t begin) {
+        for (size_t i = begin; i < batch.count; ++i) {
+            batch.cost[i] = batch.drones[i] + batch.shield[i] + batch.travelTime[i] * batch.regenRate[i];
+        }
+    }
+
+#if SIMD_X86
+    inline void computeAttackCostsSSE2(const AttackCostBatch& batch) {
+        size_t i = 0;
+        for (; i + 4 <= batch.count; i += 4) {
+            __m128 cost = _mm_add_ps(_mm_loadu_ps(batch.drones + i), _mm_loadu_ps(batch.shield + i));
+            cost = _mm_add_ps(cost, _mm_mul_ps(_mm_loadu_ps(batch.travelTime + i), _mm_loadu_ps(batch.regenRate + i)));
+            _mm_storeu_ps(batch.cost + i, cost);
+        }
+
+        computeAttackCostsScalar(batch, i);
+    }
+
+    SIMD_TARGET_AVX2 inline void computeAttackCostsAVX2(const AttackCostBatch& batch) {
+        size_t i = 0;
+        for (; i + 8 <= batch.count; i += 8) {
+            __m256 cost = _mm256_add_ps(_mm256_loadu_ps(batch.drones + i), _mm256_loadu_ps(batch.shield + i));
+            cost = _mm256_add_ps(cost, _mm256_mul_ps(_mm256_loadu_ps(batch.travelTime + i), _mm256_loadu_ps(batch.regenRate + i)));
+            _mm256_storeu_ps(batch.cost + i, cost);
+        }
+
+        computeAttackCostsScalar(batch, i);
+    }
+#endif
+
+    inline void computeAttackCosts(const AttackCostBatch& batch, Simd::Level level) {
+#if SIMD_X86
+        if (level == Simd::Level::AVX2) {
+            computeAttackCostsAVX2(batch);
+            return;
+        }
+        if (level == Simd::Level::SSE2) {
+            computeAttackCostsSSE2(batch);
+            return;
+        }
+#endif
+        computeAttackCostsScalar(batch, 0);
+    }
+
+    inline void computeAttackCosts(const AttackCostBatch& batch) {
+        computeAttackCosts(batch, Simd::getLevel());
+    }
+}
+
+#endif // ATTACK_COST_KERNEL_HPP
@@ -0,0 +1,157 @@
+#ifndef FLIGHT_KERNEL_HPP
+#define FLIGHT_KERNEL_HPP
+
+#include <cstddef>
+#include <algorithm>
+
+#include "Utils/Simd.hpp"
+
+// Batched evaluation of closed-form drone flights over structure-of-arrays data.
+// Every lane computes: travelled = speed * max(0, t - launchTime)
+//                      position  = arrived ? target : launch + direction * travelled
+// and reports whether the drone arrived and whether it lies inside the view rectangle.
+// All paths use the same operation order, so scalar and vector results are identical.
+
+namespace Utils::Kernels {
+
+    enum FlightFlags : unsigned char {
+        FLIGHT_VISIBLE = 1,
+        FLIGHT_ARRIVED = 2
+    };
+
+    struct FlightBatch {
+        const float* launchX;
+        const float* launchY;
+        const float* dirX;
+        const float* dirY;
+        const float* speed;
+        const float* launchTime;
+        const float* arrivalTime;
+        const float* targetX;
+        const float* targetY;
+
+        float* x;
+        float* y;
+        unsigned char* flags;
+
+        size_t count;
+    };
+
+    struct ViewRect {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    inline void evaluateFlightsScalar(const FlightBatch& batch, size_t begin, float time, const ViewRect& view) {
+        for (size_t i = begin; i < batch.count; ++i) {
+            float elapsed = std::max(time - batch.launchTime[i], 0.f);
+            float travelled = batch.speed[i] * elapsed;
+            bool arrived = time >= batch.arrivalTime[i];
+
+            float x = arrived ? batch.targetX[i] : batch.launchX[i] + batch.dirX[i] * travelled;
+            float y = arrived ? batch.targetY[i] : batch.launchY[i] + batch.dirY[i] * travelled;
+            bool visible = x >= view.left && x <= view.right && y >= view.top && y <= view.bottom;
+
+            batch.x[i] = x;
+            batch.y[i] = y;
+            batch.flags[i] = (visible ? FLIGHT_VISIBLE : 0) | (arrived ? FLIGHT_ARRIVED : 0);
+        }
+    }
+
+#if SIMD_X86
+    inline void storeFlags(unsigned char* flags, int visibleMask, int arrivedMask, int lanes) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            flags[lane] = ((visibleMask >> lane) & 1 ? FLIGHT_VISIBLE : 0) | ((arrivedMask >> lane) & 1 ? FLIGHT_ARRIVED : 0);
+        }
+    }
+
+    inline void evaluateFlightsSSE2(const FlightBatch& batch, float time, const ViewRect& view) {
+        const __m128 t = _mm_set1_ps(time);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 left = _mm_set1_ps(view.left);
+        const __m128 right = _mm_set1_ps(view.right);
+        const __m128 top = _mm_set1_ps(view.top);
+        const __m128 bottom = _mm_set1_ps(view.bottom);
+
+        size_t i = 0;
+        for (; i + 4 <= batch.count; i += 4) {
+            __m128 elapsed = _mm_max_ps(_mm_sub_ps(t, _mm_loadu_ps(batch.launchTime + i)), zero);
+            __m128 travelled = _mm_mul_ps(_mm_loadu_ps(batch.speed + i), elapsed);
+            __m128 arrived = _mm_cmpge_ps(t, _mm_loadu_ps(batch.arrivalTime + i));
+
+            __m128 flyX = _mm_add_ps(_mm_loadu_ps(batch.launchX + i), _mm_mul_ps(_mm_loadu_ps(batch.dirX + i), travelled));
+            __m128 flyY = _mm_add_ps(_mm_loadu_ps(batch.launchY + i), _mm_mul_ps(_mm_loadu_ps(batch.dirY + i), travelled));
+
+            // No blend in SSE2, select with masks
+            __m128 x = _mm_or_ps(_mm_and_ps(arrived, _mm_loadu_ps(batch.targetX + i)), _mm_andnot_ps(arrived, flyX));
+            __m128 y = _mm_or_ps(_mm_and_ps(arrived, _mm_loadu_ps(batch.targetY + i)), _mm_andnot_ps(arrived, flyY));
+
+            __m128 visible = _mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(x, left), _mm_cmple_ps(x, right)),
+                _mm_and_ps(_mm_cmpge_ps(y, top), _mm_cmple_ps(y, bottom))
+            );
+
+            _mm_storeu_ps(batch.x + i, x);
+            _mm_storeu_ps(batch.y + i, y);
+            storeFlags(batch.flags + i, _mm_movemask_ps(visible), _mm_movemask_ps(arrived), 4);
+        }
+
+        evaluateFlightsScalar(batch, i, time, view);
+    }
+
+    SIMD_TARGET_AVX2 inline void evaluateFlightsAVX2(const FlightBatch& batch, float time, const ViewRect& view) {
+        const __m256 t = _mm256_set1_ps(time);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 left = _mm256_set1_ps(view.left);
+        const __m256 right = _mm256_set1_ps(view.right);
+        const __m256 top = _mm256_set1_ps(view.top);
+        const __m256 bottom = _mm256_set1_ps(view.bottom);
+
+        size_t i = 0;
+        for (; i + 8 <= batch.count; i += 8) {
+            __m256 elapsed = _mm256_max_ps(_mm256_sub_ps(t, _mm256_loadu_ps(batch.launchTime + i)), zero);
+            __m256 travelled = _mm256_mul_ps(_mm256_loadu_ps(batch.speed + i), elapsed);
+            __m256 arrived = _mm256_cmp_ps(t, _mm256_loadu_ps(batch.arrivalTime + i), _CMP_GE_OQ);
+
+            __m256 flyX = _mm256_add_ps(_mm256_loadu_ps(batch.launchX + i), _mm256_mul_ps(_mm256_loadu_ps(batch.dirX + i), travelled));
+            __m256 flyY = _mm256_add_ps(_mm256_loadu_ps(batch.launchY + i), _mm256_mul_ps(_mm256_loadu_ps(batch.dirY + i), travelled));
+
+            __m256 x = _mm256_blendv_ps(flyX, _mm256_loadu_ps(batch.targetX + i), arrived);
+            __m256 y = _mm256_blendv_ps(flyY, _mm256_loadu_ps(batch.targetY + i), arrived);
+
+            __m256 visible = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(x, left, _CMP_GE_OQ), _mm256_cmp_ps(x, right, _CMP_LE_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(y, top, _CMP_GE_OQ), _mm256_cmp_ps(y, bottom, _CMP_LE_OQ))
+            );
+
+            _mm256_storeu_ps(batch.x + i, x);
+            _mm256_storeu_ps(batch.y + i, y);
+            storeFlags(batch.flags + i, _mm256_movemask_ps(visible), _mm256_movemask_ps(arrived), 8);
+        }
+
+        evaluateFlightsScalar(batch, i, time, view);
+    }
+#endif
+
+    inline void evaluateFlights(const FlightBatch& batch, float time, const ViewRect& view, Simd::Level level) {
+#if SIMD_X86
+        if (level == Simd::Level::AVX2) {
+            evaluateFlightsAVX2(batch, time, view);
+            return;
+        }
+        if (level == Simd::Level::SSE2) {
+            evaluateFlightsSSE2(batch, time, view);
+            return;
+        }
+#endif
+        evaluateFlightsScalar(batch, 0, time, view);
+    }
+
+    inline void evaluateFlights(const FlightBatch& batch, float time, const ViewRect& view) {
+        evaluateFlights(batch, time, view, Simd::getLevel());
+    }
+}
+
+#endif // FLIGHT_KERNEL_HPP
@@ -0,0 +1,114 @@
+#ifndef FLOCKING_KERNEL_HPP
+#define FLOCKING_KERNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#include "Utils/SpatialHash.hpp"
+
+// Separation and cohesion between drones of the same fleet, as an offset from their flight path.
+// A pass has two phases over structure-of-arrays data, each over an index range so both can be split across threads:
+//   steer:     reads the displayed positions (path + offset) of the fleet's neighbours found in the spatial hash,
+//              which is keyed by fleet so other fleets flying through are not even visited
+//   integrate: turns the steering into offset velocity and offset, springing back towards the path
+// Flights themselves are untouched, arrivals stay exact.
+
+namespace Utils::Kernels {
+
+    struct FlockParameters {
+        float radius;       // Neighbourhood, also the spatial hash cell size
+        float separation;   // Push away from close neighbours
+        float cohesion;     // Pull towards the neighbours' center
+        float spring;       // Pull back towards the flight path
+        float damping;      // Velocity lost per second
+        float maxOffset;    // Furthest a drone strays from its path
+    };
+
+    struct FlockBatch {
+        const float* displayX;   // Path position plus offset
+        const float* displayY;
+        const std::uint32_t* fleet;
+        float* offsetX;
+        float* offsetY;
+        float* velocityX;
+        float* velocityY;
+        float* steerX;
+        float* steerY;
+        size_t count;
+    };
+
+    inline void steerFlock(const FlockBatch& batch, const SpatialHash& hash, const FlockParameters& parameters, size_t begin, size_t end) {
+        float radiusSquared = parameters.radius * parameters.radius;
+
+        for (size_t i = begin; i < end; ++i) {
+            float px = batch.displayX[i];
+            float py = batch.displayY[i];
+            std::uint32_t fleet = batch.fleet[i];
+
+            float pushX = 0.f, pushY = 0.f;
+            float centerX = 0.f, centerY = 0.f;
+            int neighbours = 0;
+
+            hash.forEachNear(px, py, fleet, [&](std::uint32_t j) {
+                if (j == i || batch.fleet[j] != fleet) {
+                    return;
+                }
+                float dx = px - batch.displayX[j];
+                float dy = py - batch.displayY[j];
+                float distanceSquared = dx * dx + dy * dy;
+                if (distanceSquared >= radiusSquared) {
+                    return;
+                }
+                if (distanceSquared < 1e-4f) {
+                    // Stacked exactly, split them along a direction picked by index
+                    dx = j < i ? 1.f : -1.f;
+                    dy = 0.f;
+                    distanceSquared = 1.f;
+                }
+                float distance = std::sqrt(distanceSquared);
+                float weight = (parameters.radius - distance) / (parameters.radius * distance);
+                pushX += dx * weight;
+                pushY += dy * weight;
+                centerX += batch.displayX[j];
+                centerY += batch.displayY[j];
+                neighbours++;
+            });
+
+            float steerX = pushX * parameters.separation - batch.offsetX[i] * parameters.spring;
+            float steerY = pushY * parameters.separation - batch.offsetY[i] * parameters.spring;
+            if (neighbours > 0) {
+                steerX += (centerX / neighbours - px) * parameters.cohesion;
+                steerY += (centerY / neighbours - py) * parameters.cohesion;
+            }
+            batch.steerX[i] = steerX;
+            batch.steerY[i] = steerY;
+        }
+    }
+
+    inline void integrateFlock(const FlockBatch& batch, const FlockParameters& parameters, float dt, size_t begin, size_t end) {
+        float keep = std::max(0.f, 1.f - parameters.damping * dt);
+        float maxOffsetSquared = parameters.maxOffset * parameters.maxOffset;
+
+        for (size_t i = begin; i < end; ++i) {
+            float vx = (batch.velocityX[i] + batch.steerX[i] * dt) * keep;
+            float vy = (batch.velocityY[i] + batch.steerY[i] * dt) * keep;
+            float ox = batch.offsetX[i] + vx * dt;
+            float oy = batch.offsetY[i] + vy * dt;
+
+            float offsetSquared = ox * ox + oy * oy;
+            if (offsetSquared > maxOffsetSquared) {
+                float scale = parameters.maxOffset / std::sqrt(offsetSquared);
+                ox *= scale;
+                oy *= scale;
+            }
+            batch.velocityX[i] = vx;
+            batch.velocityY[i] = vy;
+            batch.offsetX[i] = ox;
+            batch.offsetY[i] = oy;
+        }
+    }
+}
+
+#endif // FLOCKING_KERNEL_HPP
@@ -0,0 +1,42 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+namespace Utils::Hash {
+
+    // SplitMix64 finaliser, every input bit affects every output bit
+    inline std::uint64_t mix(std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    // Order-dependent combination, for values visited in a fixed order
+    inline std::uint64_t combine(std::uint64_t hash, std::uint64_t value) {
+        return mix(hash ^ mix(value));
+    }
+
+    // Exact bit pattern, for values that must match to the last bit
+    inline std::uint64_t ofFloat(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline std::uint64_t ofDouble(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Positions on a 1/16 pixel grid
+    inline std::uint64_t ofPosition(float value) {
+        return static_cast<std::uint64_t>(std::llround(value * 16.f));
+    }
+}
+
+#endif // HASH_HPP
@@ -0,0 +1,329 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+
+#include "Config.hpp"
+
+namespace Utils {
+
+    // Frame profiler: named zones timed around systems, summed per frame and kept for the last PROFILER_FRAMES frames.
+    // Every thread records its zones into a ring of its own, only that thread writes it and the main thread
+    // drains all of them once a frame, so recording takes no lock. Zones only record while the profiler is enabled,
+    // a zone otherwise costs one relaxed load.
+    class Profiler {
+    public:
+        // Milliseconds per frame over the kept frames
+        struct ZoneStats {
+            const char* name;
+            unsigned int depth;     // Zones it runs in
+            float average;
+            float p95;
+            float max;
+        };
+
+        static Profiler& getInstance() {
+            static Profiler instance;
+            return instance;
+        }
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        void setEnabled(bool enable) {
+            if (enable && !isEnabled()) {
+                reset();
+            }
+            enabled.store(enable, std::memory_order_relaxed);
+        }
+
+        bool isEnabled() const {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        // Nanoseconds since the profiler was created
+        std::uint64_t now() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+        }
+
+        void record(const char* name, std::uint64_t start, std::uint64_t end) {
+            thread_local Ring* ring = nullptr;
+            if (!ring) {
+                ring = addRing();
+            }
+            ring->push(Sample{name, start, end});
+        }
+
+        // Called by the main thread once a frame: drains the rings and closes the frame
+        void endFrame() {
+            std::uint64_t frameEnd = now();
+            if (!isEnabled()) {
+                lastFrameEnd = frameEnd;
+                return;
+            }
+
+            std::fill(frameTotals.begin(), frameTotals.end(), 0.f);
+            {
+                std::lock_guard<std::mutex> lock(ringsMutex);
+                for (auto& ring : rings) {
+                    drained.clear();
+                    ring->drain(drained);
+                    // Outer zones end after the zones inside them, by start they come first
+                    std::sort(drained.begin(), drained.end(), [](const Sample& a, const Sample& b) {
+                        return a.start != b.start ? a.start < b.start : a.end > b.end;
+                    });
+                    open.clear();
+                    for (auto& sample : drained) {
+                        while (!open.empty() && open.back()->end <= sample.start) {
+                            open.pop_back();
+                        }
+                        const char* parent = open.empty() ? nullptr : open.back()->name;
+                        frameTotals[getZone(sample.name, parent)] += (sample.end - sample.start) * 1e-6f;
+                        open.push_back(&sample);
+                    }
+                }
+            }
+
+            for (size_t zone = 0; zone < zones.size(); ++zone) {
+                zones[zone].history[frameCursor] = frameTotals[zone];
+            }
+            frameTimes[frameCursor] = lastFrameEnd > 0 ? (frameEnd - lastFrameEnd) * 1e-6f : 0.f;
+            frameCursor = (frameCursor + 1) % Config::PROFILER_FRAMES;
+            frameCount = std::min<size_t>(frameCount + 1, Config::PROFILER_FRAMES);
+            lastFrameEnd = frameEnd;
+        }
+
+        // Statistics of every zone seen since the profiler was enabled, each zone listed after the zone it first ran in
+        void getStats(std::vector<ZoneStats>& out) const {
+            out.clear();
+            std::vector<float> sorted;
+            for (auto& zone : zones) {
+                out.push_back(getStats(zone.name, zone.depth, zone.history, sorted));
+            }
+        }
+
+        ZoneStats getFrameStats() const {
+            std::vector<float> sorted;
+            return getStats("Frame", 0, frameTimes, sorted);
+        }
+
+        // Frame times in ms, oldest first
+        void getFrameTimes(std::vector<float>& out) const {
+            out.clear();
+            for (size_t i = 0; i < frameCount; ++i) {
+                out.push_back(frameTimes[(frameCursor + Config::PROFILER_FRAMES - frameCount + i) % Config::PROFILER_FRAMES]);
+            }
+        }
+
+        size_t getFrameCount() const {
+            return frameCount;
+        }
+
+        // Zones lost to full rings, a thread recorded more than PROFILER_RING_SIZE in one frame
+        std::uint64_t getDroppedSamples() const {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            std::uint64_t dropped = 0;
+            for (auto& ring : rings) {
+                dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+            return dropped;
+        }
+
+    private:
+        struct Sample {
+            const char* name;
+            std::uint64_t start;
+            std::uint64_t end;
+        };
+
+        // Single producer, single consumer: head is only written by the owning thread, tail by the main thread
+        struct Ring {
+            static constexpr size_t MASK = Config::PROFILER_RING_SIZE - 1;
+            static_assert((Config::PROFILER_RING_SIZE & MASK) == 0, "The profiler ring size must be a power of two");
+
+            std::array<Sample, Config::PROFILER_RING_SIZE> samples;
+            std::atomic<size_t> head{0};
+            std::atomic<size_t> tail{0};
+            std::atomic<std::uint64_t> dropped{0};
+
+            void push(const Sample& sample) {
+                size_t position = head.load(std::memory_order_relaxed);
+                if (position - tail.load(std::memory_order_acquire) == Config::PROFILER_RING_SIZE) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                samples[position & MASK] = sample;
+                head.store(position + 1, std::memory_order_release);
+            }
+
+            void drain(std::vector<Sample>& out) {
+                size_t position = tail.load(std::memory_order_relaxed);
+                size_t end = head.load(std::memory_order_acquire);
+                for (; position != end; ++position) {
+                    out.push_back(samples[position & MASK]);
+                }
+                tail.store(position, std::memory_order_release);
+            }
+        };
+
+        struct Zone {
+            const char* name;
+            unsigned int depth;
+            std::vector<float> history;     // ms per frame, frameCursor is the next one written
+        };
+
+        std::atomic<bool> enabled{false};
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+        mutable std::mutex ringsMutex;              // Guards the list, not the rings
+        std::vector<std::unique_ptr<Ring>> rings;   // One per thread that recorded, kept for the profiler's lifetime
+
+        // Main thread only
+        std::vector<Zone> zones;
+        std::vector<float> frameTotals;
+        std::vector<Sample> drained;
+        std::vector<const Sample*> open;
+        std::vector<float> frameTimes = std::vector<float>(Config::PROFILER_FRAMES, 0.f);
+        size_t frameCursor = 0;
+        size_t frameCount = 0;
+        std::uint64_t lastFrameEnd = 0;
+
+        Profiler() = default;
+
+        Ring* addRing() {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            rings.push_back(std::make_unique<Ring>());
+            return rings.back().get();
+        }
+
+        // Zones are told apart by the text of their names, equal literals in two translation units need not share
+        // an address. A zone is listed after the zones that already run in its parent, the zone open around it on
+        // its thread. Zones of worker tasks have none on the worker, they move under their parent once the calling
+        // thread is seen running one.
+        size_t getZone(const char* name, const char* parent) {
+            size_t zone = findZone(name);
+            if (zone < zones.size() && (zones[zone].depth > 0 || !parent)) {
+                return zone;
+            }
+
+            std::vector<Zone> moved;
+            std::vector<float> movedTotals;
+            if (zone < zones.size()) {
+                size_t end = getSubtreeEnd(zone);
+                moved.assign(std::make_move_iterator(zones.begin() + zone), std::make_move_iterator(zones.begin() + end));
+                movedTotals.assign(frameTotals.begin() + zone, frameTotals.begin() + end);
+                zones.erase(zones.begin() + zone, zones.begin() + end);
+                frameTotals.erase(frameTotals.begin() + zone, frameTotals.begin() + end);
+            } else {
+                moved.push_back(Zone{name, 0, std::vector<float>(Config::PROFILER_FRAMES, 0.f)});
+                movedTotals.push_back(0.f);
+            }
+
+            size_t parentZone = parent ? findZone(parent) : zones.size();
+            size_t position = zones.size();
+            unsigned int depth = 0;
+            if (parentZone < zones.size()) {
+                depth = zones[parentZone].depth + 1;
+                position = getSubtreeEnd(parentZone);
+            }
+            for (auto& child : moved) {
+                child.depth += depth;
+            }
+            zones.insert(zones.begin() + position, std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+            frameTotals.insert(frameTotals.begin() + position, movedTotals.begin(), movedTotals.end());
+            return position;
+        }
+
+        size_t findZone(const char* name) const {
+            for (size_t zone = 0; zone < zones.size(); ++zone) {
+                if (zones[zone].name == name || std::strcmp(zones[zone].name, name) == 0) {
+                    return zone;
+                }
+            }
+            return zones.size();
+        }
+
+        // One past the last zone listed under a zone
+        size_t getSubtreeEnd(size_t zone) const {
+            size_t end = zone + 1;
+            while (end < zones.size() && zones[end].depth > zones[zone].depth) {
+                end++;
+            }
+            return end;
+        }
+
+        // Zones seen earlier start over, samples recorded while disabled are dropped with the rest
+        void reset() {
+            zones.clear();
+            frameTotals.clear();
+            std::fill(frameTimes.begin(), frameTimes.end(), 0.f);
+            frameCursor = 0;
+            frameCount = 0;
+
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            for (auto& ring : rings) {
+                drained.clear();
+                ring->drain(drained);
+            }
+            drained.clear();
+        }
+
+        ZoneStats getStats(const char* name, unsigned int depth, const std::vector<float>& history, std::vector<float>& sorted) const {
+            ZoneStats stats{name, depth, 0.f, 0.f, 0.f};
+            if (frameCount == 0) {
+                return stats;
+            }
+            sorted.clear();
+            for (size_t i = 0; i < frameCount; ++i) {
+                sorted.push_back(history[(frameCursor + Config::PROFILER_FRAMES - frameCount + i) % Config::PROFILER_FRAMES]);
+            }
+            float total = 0.f;
+            for (float value : sorted) {
+                total += value;
+                stats.max = std::max(stats.max, value);
+            }
+            stats.average = total / frameCount;
+            auto p95 = sorted.begin() + (frameCount * 95) / 100;
+            std::nth_element(sorted.begin(), p95, sorted.end());
+            stats.p95 = *p95;
+            return stats;
+        }
+    };
+
+    // Times the scope it is declared in as one zone of the current frame
+    class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name) {
+            auto& profiler = Profiler::getInstance();
+            if (profiler.isEnabled()) {
+                this->name = name;
+                start = profiler.now();
+            }
+        }
+
+        ~ProfileZone() {
+            if (name) {
+                auto& profiler = Profiler::getInstance();
+                profiler.record(name, start, profiler.now());
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* name = nullptr;
+        std::uint64_t start = 0;
+    };
+}
+
+#endif // PROFILER_HPP
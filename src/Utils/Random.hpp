@@ -2,14 +2,75 @@
 #define RANDOM_HPP
 
 #include <random>
+#include <cstdint>
 
 namespace Utils{
-    float getRandomFloat(float min, float max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dist(min, max);
-        return dist(gen);
+
+    // Seeded random source owned by the world, the same seed generates the same match.
+    // Values are built from the raw engine output, std distributions differ between standard libraries.
+    class Random {
+    public:
+        explicit Random(std::uint32_t seed = 0) {
+            setSeed(seed);
+        }
+
+        void setSeed(std::uint32_t seed) {
+            this->seed = seed;
+            gen.seed(seed);
+            draws = 0;
+        }
+
+        std::uint32_t getSeed() const {
+            return seed;
+        }
+
+        // Engine and draw count at one point of the match, kept by rewind keyframes
+        struct State {
+            std::mt19937 gen;
+            std::uint64_t draws = 0;
+        };
+
+        // Values drawn since seeding
+        std::uint64_t getDraws() const {
+            return draws;
+        }
+
+        State getState() const {
+            return State{gen, draws};
+        }
+
+        // Back to a saved state, then forward to a later draw count. Only the draws after the state are replayed.
+        void restore(const State& state, std::uint64_t draws) {
+            gen = state.gen;
+            gen.discard(draws - state.draws);
+            this->draws = draws;
+        }
+
+        // Uniform in [min, max)
+        float getFloat(float min, float max) {
+            draws++;
+            return min + (max - min) * static_cast<float>(gen() >> 8) * (1.f / 16777216.f);
+        }
+
+        // Uniform in [min, max)
+        int getInt(int min, int max) {
+            if (max <= min) {
+                return min;
+            }
+            draws++;
+            return min + static_cast<int>(gen() % static_cast<std::uint32_t>(max - min));
+        }
+
+    private:
+        std::uint32_t seed = 0;
+        std::uint64_t draws = 0;
+        std::mt19937 gen;
+    };
+
+    // Seed for a match started without one
+    inline std::uint32_t makeSeed() {
+        return std::random_device{}();
     }
 }
 
-#endif // RANDOM_HPP
\ No newline at end of file
+#endif // RANDOM_HPP
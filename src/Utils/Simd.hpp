@@ -0,0 +1,76 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+// Runtime selection of the widest vector instruction set available on the CPU.
+// SSE2 is part of the x86-64 baseline, 32-bit x86 only gets the vector paths when
+// the compiler was told to assume SSE2, otherwise it stays scalar. AVX2 code paths
+// are compiled per function with a target attribute and only called after the CPU
+// reported support.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define SIMD_TARGET_AVX2
+    #else
+        #define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#else
+    #define SIMD_X86 0
+    #define SIMD_TARGET_AVX2
+#endif
+
+namespace Utils::Simd {
+
+    enum class Level : unsigned int {
+        SCALAR = 0,
+        SSE2 = 1,
+        AVX2 = 2
+    };
+
+    inline const char* getLevelName(Level level) {
+        switch (level) {
+            case Level::AVX2: return "AVX2";
+            case Level::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+
+    inline Level detectLevel() {
+#if SIMD_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            // The OS must also save the upper halves of the YMM registers
+            if (osxsave && avx && avx2 && (_xgetbv(0) & 0x6) == 0x6) {
+                return Level::AVX2;
+            }
+        }
+        return Level::SSE2;
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Level::AVX2;
+        }
+        return Level::SSE2;
+    #endif
+#else
+        return Level::SCALAR;
+#endif
+    }
+
+    // Detected once, the result does not change while the process runs
+    inline Level getLevel() {
+        static Level level = detectLevel();
+        return level;
+    }
+}
+
+#endif // SIMD_HPP
@@ -0,0 +1,105 @@
+#ifndef SPATIAL_HASH_HPP
+#define SPATIAL_HASH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+namespace Utils {
+
+    // Uniform grid over an unbounded plane, cells hashed into a power-of-two bucket table.
+    // Rebuilt from scratch with a counting sort (count per bucket, prefix sum, scatter),
+    // so points of a bucket are contiguous and a neighbour query reads at most nine short runs.
+    // Queries only read the table and can run in parallel once it is built.
+    // Points may carry a group key, a query then only sees its own group: a cell of each group hashes to its own bucket.
+    class SpatialHash {
+    public:
+        void build(const float* x, const float* y, size_t count, float cellSize) {
+            build(x, y, nullptr, count, cellSize);
+        }
+
+        void build(const float* x, const float* y, const std::uint32_t* keys, size_t count, float cellSize) {
+            inverseCellSize = 1.f / cellSize;
+
+            size_t buckets = 64;
+            while (buckets < count * 2) {
+                buckets <<= 1;
+            }
+            mask = static_cast<std::uint32_t>(buckets - 1);
+
+            start.assign(buckets + 1, 0);
+            bucketOfItem.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                std::uint32_t bucket = getBucket(getCell(x[i]), getCell(y[i]), keys ? keys[i] : 0);
+                bucketOfItem[i] = bucket;
+                start[bucket + 1]++;
+            }
+            for (size_t bucket = 0; bucket < buckets; ++bucket) {
+                start[bucket + 1] += start[bucket];
+            }
+
+            cursor.assign(start.begin(), start.end() - 1);
+            items.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                items[cursor[bucketOfItem[i]]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        // Calls visit(index) for every point in the 3x3 cells around the position, each point once.
+        // Points further than one cell away may be visited too when buckets collide, callers test the distance.
+        template<typename Visit>
+        void forEachNear(float px, float py, Visit visit) const {
+            forEachNear(px, py, 0, visit);
+        }
+
+        // Same, within the points built with the given key. Other groups may show up when buckets collide.
+        template<typename Visit>
+        void forEachNear(float px, float py, std::uint32_t key, Visit visit) const {
+            int cx = getCell(px);
+            int cy = getCell(py);
+            std::uint32_t visited[9];
+            int visitedCount = 0;
+
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    std::uint32_t bucket = getBucket(cx + dx, cy + dy, key);
+                    bool seen = false;
+                    for (int i = 0; i < visitedCount; ++i) {
+                        seen |= visited[i] == bucket;
+                    }
+                    if (seen) {
+                        continue;
+                    }
+                    visited[visitedCount++] = bucket;
+
+                    for (std::uint32_t k = start[bucket]; k < start[bucket + 1]; ++k) {
+                        visit(items[k]);
+                    }
+                }
+            }
+        }
+
+        size_t size() const {
+            return items.size();
+        }
+
+    private:
+        float inverseCellSize = 1.f;
+        std::uint32_t mask = 0;
+        std::vector<std::uint32_t> start;       // First item of each bucket, plus the end
+        std::vector<std::uint32_t> cursor;      // Scatter position while building
+        std::vector<std::uint32_t> items;       // Point indices grouped by bucket
+        std::vector<std::uint32_t> bucketOfItem;
+
+        int getCell(float value) const {
+            return static_cast<int>(std::floor(value * inverseCellSize));
+        }
+
+        std::uint32_t getBucket(int cx, int cy, std::uint32_t key) const {
+            return ((static_cast<std::uint32_t>(cx) * 0x8da6b343u) ^ (static_cast<std::uint32_t>(cy) * 0xd8163841u) ^ (key * 0xcb1ab31fu)) & mask;
+        }
+    };
+}
+
+#endif // SPATIAL_HASH_HPP
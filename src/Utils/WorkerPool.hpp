@@ -0,0 +1,145 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+namespace Utils {
+
+    // Worker threads kept alive across ticks, running one batch of tasks at a time.
+    // The calling thread takes tasks too, a pool of one thread runs every task inline.
+    // Tasks of a batch must only write to state of their own, which task runs on which thread is not fixed.
+    class WorkerPool {
+    public:
+        explicit WorkerPool(unsigned int threads = 1) {
+            setThreadCount(threads);
+        }
+
+        ~WorkerPool() {
+            stop();
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Total threads including the caller, at least one
+        void setThreadCount(unsigned int threads) {
+            threads = std::max(1u, threads);
+            if (threads == getThreadCount()) {
+                return;
+            }
+            stop();
+            stopping = false;
+            for (unsigned int i = 1; i < threads; ++i) {
+                workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        unsigned int getThreadCount() const {
+            return static_cast<unsigned int>(workers.size()) + 1;
+        }
+
+        // Call task(index) for every index below count, returns once all of them are done
+        void run(size_t count, const std::function<void(size_t)>& task) {
+            if (count == 0) {
+                return;
+            }
+            if (workers.empty() || count == 1) {
+                for (size_t index = 0; index < count; ++index) {
+                    task(index);
+                }
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                // A worker that woke up late may still be looking at the previous batch
+                done.wait(lock, [this]() { return active == 0; });
+                batch = &task;
+                batchSize = count;
+                nextTask = 0;
+                pending = count;
+                generation++;
+            }
+            wake.notify_all();
+            runTasks(task, count);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this]() { return pending == 0; });
+            batch = nullptr;
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        // The batch in progress, guarded by the mutex, tasks are claimed from the atomic counter
+        const std::function<void(size_t)>* batch = nullptr;
+        size_t batchSize = 0;
+        std::atomic<size_t> nextTask{0};
+        size_t pending = 0;             // Tasks not finished yet
+        unsigned int active = 0;        // Workers holding the batch
+        unsigned long generation = 0;
+        bool stopping = false;
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            workers.clear();
+        }
+
+        void work() {
+            unsigned long seen = 0;
+            for (;;) {
+                const std::function<void(size_t)>* task = nullptr;
+                size_t count = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&]() { return stopping || generation != seen; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen = generation;
+                    if (!batch) {
+                        continue;
+                    }
+                    task = batch;
+                    count = batchSize;
+                    active++;
+                }
+                runTasks(*task, count);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    active--;
+                }
+                done.notify_all();
+            }
+        }
+
+        void runTasks(const std::function<void(size_t)>& task, size_t count) {
+            size_t finished = 0;
+            for (size_t index = nextTask++; index < count; index = nextTask++) {
+                task(index);
+                finished++;
+            }
+            if (finished > 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending -= finished;
+            }
+            done.notify_all();
+        }
+    };
+}
+
+#endif // WORKER_POOL_HPP
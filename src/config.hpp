@@ -11,15 +11,80 @@ namespace Config {
     const unsigned int FACTORY_SIZE = 50;
     const unsigned int POWER_PLANT_RADIUS = 25;
     const float DRONE_LENGTH = 10.f;
+    const float INTERCEPT_RADIUS = 6.f;      // Opposing drones closer than this destroy each other
+
+    // Fog of war, distance structures and drones see
+    const bool ENABLE_FOG_OF_WAR = true;
+    const float VISION_STRUCTURE_RADIUS = 200.f;
+    const float VISION_DRONE_RADIUS = 60.f;
+
+    const float POWER_LINK_RADIUS = 250.f;   // Structures of one owner this close share their power grid
+
+    // Structure distance table, the full matrix takes 8 bytes per pair, 512 KB at the cutoff
+    const unsigned int DISTANCE_MATRIX_MAX_STRUCTURES = 256;
+    const unsigned int DISTANCE_NEIGHBOURS = 32;     // Closest structures kept per structure on bigger maps
+
+    // Strength by map region, and the distance the AI and the hover panel weigh nearby forces within
+    const float REGION_CELL_SIZE = 120.f;
+    const float STRENGTH_RADIUS = 400.f;
 
     constexpr float RAD_TO_DEG = 180.f / 3.14159265358979323846f;
 
     // GUI consts
     constexpr float GUI_TEXT_SIZE = 18.f;
     const bool ENABLE_DEBUG_SYMBOLS = false;
+    const float PICKING_CELL_SIZE = 64.f;    // Grid the mouse is looked up in, about the size of a structure
+
+    // Frame profiler, F3 shows the overlay and only then are zones recorded
+    const unsigned int PROFILER_FRAMES = 240;           // Frames the overlay statistics and graph cover
+    const unsigned int PROFILER_RING_SIZE = 4096;       // Zones a thread can record per frame, a power of two
+    const unsigned int PROFILER_REFRESH_FRAMES = 15;    // Frames between two overlay updates
 
     // Game consts
     const float DRONE_SPEED = 100.f;
+    const unsigned int DRONE_POOL_CAPACITY = 4096;  // Dead drone entities kept for reuse
+    const float LAUNCH_RATE = 60.f;                 // Drones per second leaving a structure in an attack wave
+    const unsigned int LAUNCH_BUDGET_PER_TICK = 16; // Drones launched per tick by all waves together
+
+    // Drone navigation around structures
+    const float NAVIGATION_CELL_SIZE = 20.f;        // Flow field grid
+    const float NAVIGATION_CLEARANCE = 10.f;        // Kept between drones and structure outlines
+
+    // Drone flocking, drawn offsets from the flight path within a fleet
+    const float FLOCK_RADIUS = 24.f;
+    const float FLOCK_SEPARATION = 600.f;
+    const float FLOCK_COHESION = 1.f;
+    const float FLOCK_SPRING = 2.f;
+    const float FLOCK_DAMPING = 3.f;
+    const float FLOCK_MAX_OFFSET = 40.f;
+    const float FLOCK_MAX_STEP_SEC = 0.1f;
+
+    // Simulation stepping
+    const float SIMULATION_STEP_SEC = 1.f / 60.f;  // Fixed step, at every speed
+    const double FLIGHT_EPOCH_SEC = 60.0;          // Flight kernels count time in float from the last multiple of this
+    const float SIMULATION_BUDGET_SEC = 0.012f;     // Wall-clock time per frame the steps may use
+    const float MAX_FRAME_TIME_SEC = 0.25f;
+    const unsigned int DEGRADED_HOLD_FRAMES = 30;   // Frames to stay degraded after falling behind
+    const unsigned int DEGRADED_RENDER_INTERVAL = 4;
+    const float SHARD_TILE_SIZE = 240.f;            // Map tiles the drones in flight are split into for the worker threads
+    const unsigned int DEFAULT_WORKER_THREADS = 1;  // Including the main thread
+
+    // Rewind history
+    const bool ENABLE_REWIND = true;
+    const float REWIND_HISTORY_SEC = 300.f;        // How far back a match can be scrubbed
+    const float REWIND_KEYFRAME_INTERVAL_SEC = 10.f; // Longest replay a seek has to do
+    const float REWIND_SEEK_STEP_SEC = 10.f;       // Jump of one key press
+
+    // Determinism checking
+#ifndef NDEBUG
+    const bool ENABLE_STATE_HASH = true;            // Hash the world after every tick
+#else
+    const bool ENABLE_STATE_HASH = false;           // Only when a hash log is written
+#endif
+    const unsigned int DETERMINISM_CHECK_TICKS = 3600; // One minute of simulated time
+
+    const unsigned int DEFAULT_PLAYER_COUNT = 2;       // Local player and one AI, up to 16 for free-for-all
+    const unsigned int AI_TARGETS_PER_GARRISON = 16;   // Closest structures an AI garrison weighs as targets
     
     // Game Difficulty
     struct Difficulty {
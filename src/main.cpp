@@ -2,21 +2,80 @@
 #include <TGUI/TGUI.hpp>
 #include <TGUI/Backend/SFML-Graphics.hpp>
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdint>
 
 #include "gui.hpp"
 #include "Game/Scene.hpp"
+#include "Game/Simulation.hpp"
+#include "Game/Command.hpp"
 #include "Config.hpp"
+#include "Utils/Random.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
 
 #include "Core/Entity.hpp"
-int main() {
-    // seed srand
-    srand(time(NULL));
+
+// Command line:
+//   --seed N                 play the match generated from seed N
+//   --players N              number of players, 2 to 16, every player but the first is an AI
+//   --hyperlanes             drones only fly along the lanes between structures
+//   --threads N              worker threads for the simulation, the determinism check compares them against one
+//   --commands FILE          replay the player commands recorded in FILE
+//   --record-commands FILE   save the player commands to FILE on exit
+//   --hash-log FILE          write the state hash of every tick to FILE
+//   --determinism-check      play seed and commands twice without a window and compare the hashes
+//   --ticks N                length of the determinism check
+int main(int argc, char* argv[]) {
+    std::uint32_t seed = Utils::makeSeed();
+    std::uint64_t ticks = Config::DETERMINISM_CHECK_TICKS;
+    unsigned int players = Config::DEFAULT_PLAYER_COUNT;
+    std::string commandsPath, recordPath, hashLogPath;
+    bool determinismCheck = false;
+    bool hyperlanes = false;
+    unsigned int threads = Config::DEFAULT_WORKER_THREADS;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seed" && hasValue) seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--players" && hasValue) players = static_cast<unsigned int>(std::stoul(argv[++i]));
+        else if (arg == "--threads" && hasValue) threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+        else if (arg == "--ticks" && hasValue) ticks = std::stoull(argv[++i]);
+        else if (arg == "--commands" && hasValue) commandsPath = argv[++i];
+        else if (arg == "--record-commands" && hasValue) recordPath = argv[++i];
+        else if (arg == "--hash-log" && hasValue) hashLogPath = argv[++i];
+        else if (arg == "--determinism-check") determinismCheck = true;
+        else if (arg == "--hyperlanes") hyperlanes = true;
+        else log_err << "Unknown argument " << arg;
+    }
+
+    Game::CommandLog commands;
+    if (!commandsPath.empty() && !commands.load(commandsPath)) {
+        log_err << "Could not read commands from " << commandsPath;
+        return 1;
+    }
+
+    if (determinismCheck) {
+        return Game::RunDeterminismCheck(seed, ticks, commands, players, hyperlanes, threads);
+    }
 
     // Create Window
     sf::RenderWindow window(sf::VideoMode(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT), "Fleet Dominion");
     window.setFramerateLimit(60);
 
-    Scene scene(window);
+    Scene scene(window, seed, players, hyperlanes);
+    scene.getSimulation().setWorkerThreads(threads);
+    if (!commandsPath.empty()) {
+        scene.getSimulation().setReplay(&commands);
+    }
+    std::ofstream hashLog;
+    if (!hashLogPath.empty()) {
+        hashLog.open(hashLogPath);
+        scene.getSimulation().setHashLog(&hashLog);
+    }
+
     auto time = sf::Clock();
 
     // Game Loop
@@ -42,10 +101,18 @@ int main() {
         // Update logic
         scene.update(time.restart().asSeconds());
 
-        // Render window
-        window.clear(sf::Color(50, 50, 50));
-        scene.render();
-        window.display();
+        // Render window, frames are skipped while the simulation is behind
+        if (scene.shouldRender()) {
+            window.clear(sf::Color(50, 50, 50));
+            scene.render();
+            window.display();
+        }
+
+        Utils::Profiler::getInstance().endFrame();
+    }
+
+    if (!recordPath.empty() && !scene.getSimulation().getCommandLog().save(recordPath)) {
+        log_err << "Could not write commands to " << recordPath;
     }
 
     return 0;